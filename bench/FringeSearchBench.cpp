@@ -0,0 +1,540 @@
+#include "BidirectionalFringeSearch.h"
+#include "CompactFringeGraph.h"
+#include "ContractionHierarchy.h"
+#include "FringeSearchT.h"
+#include "GeometricHeuristics.h"
+#include "GraphImporter.h"
+#include "GridFringeGraph.h"
+#include "JumpPointGraph.h"
+#include "LandmarkHeuristic.h"
+#include "NodeOrder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Measures query throughput and latency of the search engines on synthetic workloads.
+ *
+ * Every workload is generated from a fixed seed, so runs with the same options
+ * are reproducible. Results are printed as CSV, one line per graph and engine:
+ * the graph's size, build time and memory, the engine's preprocessing time, and
+ * the queries/second and p50/p99 latency of the queries that ran. The cost sum
+ * of all queries tells whether two runs found the same paths.
+ *
+ * Usage: FringeSearchBench [--graphs grid,er,scalefree,road] [--min-nodes N]
+ *                          [--max-nodes N] [--queries N] [--time-limit S] [--seed N]
+ *                          [--dimacs FILE.gr] [--map FILE.map --scen FILE.scen]
+ *
+ * Graphs are built with 10^k nodes for every k between the minimum and maximum.
+ * A DIMACS graph or a Moving AI map with its scenarios is benchmarked before
+ * them, use --graphs none to only benchmark the files. Build times of files
+ * include parsing. DIMACS graphs are also benchmarked after reverse
+ * Cuthill-McKee reordering, as dimacs-rcm, whose prep_ms includes the
+ * reordering while build_ms is the same as for dimacs.
+ */
+
+namespace {
+
+typedef std::chrono::steady_clock bench_clock;
+typedef std::pair<node_id_t, node_id_t> query_t;
+
+struct Options {
+    std::string graphs;
+    node_id_t minNodes;
+    node_id_t maxNodes;
+    unsigned int queries;
+    double timeLimit;
+    unsigned int seed;
+    std::string dimacs;
+    std::string map;
+    std::string scenarios;
+};
+
+// A graph to run queries on
+struct Workload {
+    std::string name;
+    node_id_t nodes;
+    uint64_t edges;
+    // The time to read or generate the graph and build it, without later preprocessing
+    double buildMilliseconds;
+    // Preprocessing shared by all engines, like renumbering the nodes, added to every engine's prep_ms
+    double prepMilliseconds;
+    // The size of the graph object and its arrays
+    std::size_t bytes;
+    std::vector<query_t> queries;
+};
+
+double millisecondsSince(bench_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+void printHeader() {
+    std::printf("graph,nodes,edges,build_ms,bytes_per_node,bytes_per_edge,engine,prep_ms,queries,qps,p50_us,p99_us,"
+                "cost_sum\n");
+}
+
+/*
+ * Run the workload's queries until all ran or the time limit passed, and print the results.
+ * A query that was started always finishes. Workloads without queries are reported and skipped.
+ */
+void run(const Options& options, const Workload& workload, const char* engine, double prepMilliseconds,
+         const std::function<edge_weight_t(node_id_t, node_id_t)>& query) {
+    if (workload.queries.empty()) {
+        std::fprintf(stderr, "Skipping %s on %s, the workload has no queries\n", engine, workload.name.c_str());
+        return;
+    }
+
+    std::vector<double> latencies;
+    double costSum = 0;
+
+    bench_clock::time_point start = bench_clock::now();
+    for (const query_t& q : workload.queries) {
+        bench_clock::time_point queryStart = bench_clock::now();
+        edge_weight_t cost = query(q.first, q.second);
+        latencies.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - queryStart).count());
+        if (cost != std::numeric_limits<edge_weight_t>::infinity()) {
+            costSum += cost;
+        }
+        if (millisecondsSince(start) > options.timeLimit * 1000) {
+            break;
+        }
+    }
+    double seconds = millisecondsSince(start) / 1000;
+
+    std::sort(latencies.begin(), latencies.end());
+    double p50 = latencies[(latencies.size() - 1) / 2];
+    double p99 = latencies[(latencies.size() - 1) * 99 / 100];
+
+    std::printf("%s,%u,%llu,%.1f,%.1f,%.1f,%s,%.1f,%zu,%.1f,%.1f,%.1f,%.3f\n", workload.name.c_str(), workload.nodes,
+                static_cast<unsigned long long>(workload.edges), workload.buildMilliseconds,
+                static_cast<double>(workload.bytes) / workload.nodes,
+                workload.edges == 0 ? 0.0 : static_cast<double>(workload.bytes) / workload.edges, engine,
+                workload.prepMilliseconds + prepMilliseconds, latencies.size(), latencies.size() / seconds, p50, p99,
+                costSum);
+    std::fflush(stdout);
+}
+
+// Random query pairs between nodes that pass the filter
+template <class Filter>
+std::vector<query_t> generateQueries(const Options& options, node_id_t nodes, std::mt19937& gen, Filter filter) {
+    std::uniform_int_distribution<node_id_t> node(0, nodes - 1);
+    std::vector<query_t> queries;
+    while (queries.size() < options.queries) {
+        node_id_t from = node(gen);
+        node_id_t to = node(gen);
+        if (filter(from) && filter(to)) {
+            queries.push_back(query_t(from, to));
+        }
+    }
+    return queries;
+}
+
+std::vector<query_t> generateQueries(const Options& options, node_id_t nodes, std::mt19937& gen) {
+    return generateQueries(options, nodes, gen, [](node_id_t) { return true; });
+}
+
+// Random edges with a fixed average out degree
+std::vector<CompactFringeEdge> generateErdosRenyi(node_id_t nodes, std::mt19937& gen) {
+    static const unsigned int AVERAGE_DEGREE = 4;
+
+    std::uniform_int_distribution<node_id_t> node(0, nodes - 1);
+    std::uniform_real_distribution<edge_weight_t> weight(1, 10);
+    std::vector<CompactFringeEdge> edges;
+    edges.reserve(static_cast<std::size_t>(nodes) * AVERAGE_DEGREE);
+    while (edges.size() < static_cast<std::size_t>(nodes) * AVERAGE_DEGREE) {
+        node_id_t from = node(gen);
+        node_id_t to = node(gen);
+        if (from != to) {
+            edges.push_back({from, to, weight(gen)});
+        }
+    }
+    return edges;
+}
+
+// Barabasi-Albert preferential attachment, every new node connects to three existing nodes in both directions
+std::vector<CompactFringeEdge> generateScaleFree(node_id_t nodes, std::mt19937& gen) {
+    static const unsigned int LINKS = 3;
+
+    std::uniform_real_distribution<edge_weight_t> weight(1, 10);
+    std::vector<CompactFringeEdge> edges;
+    // Every node appears once per incident edge, so sampling from it prefers high degree nodes
+    std::vector<node_id_t> endpoints;
+
+    for (node_id_t from = 0; from <= LINKS; from++) {
+        for (node_id_t to = 0; to < from; to++) {
+            edge_weight_t w = weight(gen);
+            edges.push_back({from, to, w});
+            edges.push_back({to, from, w});
+            endpoints.push_back(from);
+            endpoints.push_back(to);
+        }
+    }
+    for (node_id_t from = LINKS + 1; from < nodes; from++) {
+        std::size_t existing = endpoints.size();
+        for (unsigned int l = 0; l < LINKS; l++) {
+            node_id_t to = endpoints[std::uniform_int_distribution<std::size_t>(0, existing - 1)(gen)];
+            edge_weight_t w = weight(gen);
+            edges.push_back({from, to, w});
+            edges.push_back({to, from, w});
+            endpoints.push_back(from);
+            endpoints.push_back(to);
+        }
+    }
+    return edges;
+}
+
+/*
+ * A planar road-like network: nodes on a jittered lattice connected to most of their lattice neighbours and
+ * some diagonals, with weights of at least the Euclidean distance so the Euclidean heuristic is admissible.
+ */
+std::vector<CompactFringeEdge> generateRoad(node_id_t side, std::mt19937& gen, NodeCoordinates& coordinates) {
+    static const edge_weight_t SPACING = 100;
+
+    std::uniform_real_distribution<edge_weight_t> jitter(-0.3f * SPACING, 0.3f * SPACING);
+    std::uniform_real_distribution<edge_weight_t> detour(1, 1.3f);
+    std::uniform_real_distribution<edge_weight_t> chance(0, 1);
+
+    coordinates.x.resize(side * side);
+    coordinates.y.resize(side * side);
+    for (node_id_t y = 0; y < side; y++) {
+        for (node_id_t x = 0; x < side; x++) {
+            coordinates.x[y * side + x] = x * SPACING + jitter(gen);
+            coordinates.y[y * side + x] = y * SPACING + jitter(gen);
+        }
+    }
+
+    std::vector<CompactFringeEdge> edges;
+    auto connect = [&](node_id_t a, node_id_t b) {
+        edge_weight_t dx = coordinates.x[a] - coordinates.x[b];
+        edge_weight_t dy = coordinates.y[a] - coordinates.y[b];
+        edge_weight_t distance = std::sqrt(dx * dx + dy * dy);
+        edges.push_back({a, b, distance * detour(gen)});
+        edges.push_back({b, a, distance * detour(gen)});
+    };
+    for (node_id_t y = 0; y < side; y++) {
+        for (node_id_t x = 0; x < side; x++) {
+            node_id_t n = y * side + x;
+            if (x + 1 < side && chance(gen) < 0.9f) {
+                connect(n, n + 1);
+            }
+            if (y + 1 < side && chance(gen) < 0.9f) {
+                connect(n, n + side);
+            }
+            // At most one diagonal per lattice cell keeps the network planar
+            if (x + 1 < side && y + 1 < side && chance(gen) < 0.2f) {
+                if (chance(gen) < 0.5f) {
+                    connect(n, n + side + 1);
+                } else {
+                    connect(n + 1, n + side);
+                }
+            }
+        }
+    }
+    return edges;
+}
+
+Workload buildCompactGraph(const std::string& name, node_id_t nodes, const std::vector<CompactFringeEdge>& edges,
+                           CompactFringeGraph& graph) {
+    bench_clock::time_point start = bench_clock::now();
+    graph = CompactFringeGraph(nodes, edges);
+    Workload workload;
+    workload.name = name;
+    workload.nodes = nodes;
+    workload.edges = graph.getEdgeCount();
+    workload.buildMilliseconds = millisecondsSince(start);
+    workload.prepMilliseconds = 0;
+    workload.bytes = sizeof(graph) + graph.getAllocatedBytes();
+    return workload;
+}
+
+// Run the fringe search variants on a compact graph with the given heuristic
+template <class Heuristic>
+void runCompactEngines(const Options& options, const Workload& workload, const CompactFringeGraph& graph,
+                       const std::string& heuristicName, const Heuristic& heuristic, double prepMilliseconds) {
+    FringeSearchT<CompactFringeGraph, Heuristic> linked(graph, heuristic);
+    run(options, workload, ("fringe-" + heuristicName).c_str(), prepMilliseconds,
+        [&](node_id_t from, node_id_t to) {
+            linked.reset(from);
+            return linked.searchCost(to);
+        });
+
+    FringeSearchT<CompactFringeGraph, Heuristic, DefaultWeight, SplitFringe> split(graph, heuristic);
+    run(options, workload, ("fringe-split-" + heuristicName).c_str(), prepMilliseconds,
+        [&](node_id_t from, node_id_t to) {
+            split.reset(from);
+            return split.searchCost(to);
+        });
+
+    FringeSearchT<CompactFringeGraph, Heuristic, DefaultWeight, LinkedFringe, ColumnarSearchContext> columnar(
+            graph, heuristic);
+    run(options, workload, ("fringe-columnar-" + heuristicName).c_str(), prepMilliseconds,
+        [&](node_id_t from, node_id_t to) {
+            columnar.reset(from);
+            return columnar.searchCost(to);
+        });
+
+    BidirectionalFringeSearchT<CompactFringeGraph, Heuristic> bidirectional(graph, heuristic);
+    PathBuffer<CompactFringeGraph> path;
+    run(options, workload, ("bidirectional-" + heuristicName).c_str(), prepMilliseconds,
+        [&](node_id_t from, node_id_t to) {
+            bidirectional.reset(from);
+            bidirectional.search(to, path);
+            return bidirectional.cost(to);
+        });
+}
+
+// Graphs without coordinates are searched with landmark heuristics
+void runLandmarkEngines(const Options& options, const Workload& workload, const CompactFringeGraph& graph) {
+    static const unsigned int LANDMARKS = 16;
+
+    bench_clock::time_point start = bench_clock::now();
+    LandmarkTable landmarks(graph, LANDMARKS, LANDMARKS_AVOID, options.seed);
+    double prepMilliseconds = millisecondsSince(start);
+
+    runCompactEngines(options, workload, graph, "alt", LandmarkHeuristic(landmarks), prepMilliseconds);
+}
+
+Workload describeGrid(const std::string& name, const GridFringeGraph& grid, double buildMilliseconds) {
+    Workload workload;
+    workload.name = name;
+    workload.nodes = grid.getNodeCount();
+    workload.buildMilliseconds = buildMilliseconds;
+    workload.prepMilliseconds = 0;
+    workload.bytes = sizeof(grid) + grid.getAllocatedBytes();
+    workload.edges = 0;
+    for (node_id_t n = 0; n < grid.getNodeCount(); n++) {
+        for (GridFringeGraph::edge_iterator it = grid.getFirstOutgoing(n); it != grid.getLastOutgoing(n); ++it) {
+            workload.edges++;
+        }
+    }
+    return workload;
+}
+
+void runGridEngines(const Options& options, const Workload& workload, const GridFringeGraph& grid) {
+    FringeSearchT<GridFringeGraph, GridOctileHeuristic> search(grid);
+    run(options, workload, "fringe-octile", 0, [&](node_id_t from, node_id_t to) {
+        search.reset(from);
+        return search.searchCost(to);
+    });
+
+    BidirectionalFringeSearchT<GridFringeGraph, GridOctileHeuristic> bidirectional(grid);
+    PathBuffer<GridFringeGraph> bidirectionalPath;
+    run(options, workload, "bidirectional-octile", 0, [&](node_id_t from, node_id_t to) {
+        bidirectional.reset(from);
+        bidirectional.search(to, bidirectionalPath);
+        return bidirectional.cost(to);
+    });
+
+    JumpPointSearch jumpPointSearch(grid);
+    std::vector<node_id_t> path;
+    run(options, workload, "jps", 0, [&](node_id_t from, node_id_t to) {
+        return jumpPointSearch.search(from, to, path) ? jumpPointSearch.cost()
+                                                      : std::numeric_limits<edge_weight_t>::infinity();
+    });
+}
+
+void benchmarkGrid(const Options& options, node_id_t nodes) {
+    static const unsigned int BLOCKED_PERCENT = 20;
+
+    std::mt19937 gen(options.seed);
+    node_id_t side = static_cast<node_id_t>(std::sqrt(static_cast<double>(nodes)));
+    std::vector<uint8_t> costs(side * side);
+    std::uniform_int_distribution<unsigned int> percent(0, 99);
+    for (uint8_t& cost : costs) {
+        cost = percent(gen) < BLOCKED_PERCENT ? 0 : 1;
+    }
+
+    bench_clock::time_point start = bench_clock::now();
+    GridFringeGraph grid(side, side, costs);
+    Workload workload = describeGrid("grid", grid, millisecondsSince(start));
+    workload.queries = generateQueries(options, workload.nodes, gen,
+                                       [&](node_id_t node) { return grid.getCost(node) != 0; });
+    runGridEngines(options, workload, grid);
+}
+
+void benchmarkMovingAI(const Options& options) {
+    GraphImporter importer;
+    GridFringeGraph grid(1, 1);
+    std::vector<GridScenario> scenarios;
+    std::ifstream mapIn(options.map);
+    std::ifstream scenarioIn(options.scenarios);
+
+    bench_clock::time_point start = bench_clock::now();
+    if (!importer.readMovingAIMap(mapIn, grid) || !importer.readMovingAIScenarios(scenarioIn, scenarios)) {
+        std::fprintf(stderr, "Could not read %s and %s\n", options.map.c_str(), options.scenarios.c_str());
+        std::exit(1);
+    }
+    Workload workload = describeGrid("movingai", grid, millisecondsSince(start));
+
+    // Queries of scenarios for maps of a different size are skipped
+    for (const GridScenario& scenario : scenarios) {
+        if (scenario.width == grid.getWidth() && scenario.height == grid.getHeight()) {
+            workload.queries.push_back(query_t(scenario.startY * grid.getWidth() + scenario.startX,
+                                               scenario.goalY * grid.getWidth() + scenario.goalX));
+        }
+    }
+    if (workload.queries.empty()) {
+        std::fprintf(stderr, "No scenario in %s is for a %ux%u map\n", options.scenarios.c_str(), grid.getWidth(),
+                     grid.getHeight());
+        return;
+    }
+    runGridEngines(options, workload, grid);
+}
+
+void runContractionHierarchy(const Options& options, const Workload& workload, const CompactFringeGraph& graph) {
+    bench_clock::time_point start = bench_clock::now();
+    ContractionHierarchy hierarchy(graph);
+    double prepMilliseconds = millisecondsSince(start);
+    ContractionHierarchyQuery query(hierarchy);
+    run(options, workload, "ch", prepMilliseconds, [&](node_id_t from, node_id_t to) {
+        return query.search(from, to);
+    });
+}
+
+void benchmarkErdosRenyi(const Options& options, node_id_t nodes) {
+    std::mt19937 gen(options.seed);
+    CompactFringeGraph graph;
+    Workload workload = buildCompactGraph("er", nodes, generateErdosRenyi(nodes, gen), graph);
+    workload.queries = generateQueries(options, nodes, gen);
+    runLandmarkEngines(options, workload, graph);
+}
+
+void benchmarkScaleFree(const Options& options, node_id_t nodes) {
+    std::mt19937 gen(options.seed);
+    CompactFringeGraph graph;
+    Workload workload = buildCompactGraph("scalefree", nodes, generateScaleFree(nodes, gen), graph);
+    workload.queries = generateQueries(options, nodes, gen);
+    runLandmarkEngines(options, workload, graph);
+}
+
+void benchmarkRoad(const Options& options, node_id_t nodes) {
+    std::mt19937 gen(options.seed);
+    node_id_t side = static_cast<node_id_t>(std::sqrt(static_cast<double>(nodes)));
+    NodeCoordinates coordinates;
+    std::vector<CompactFringeEdge> edges = generateRoad(side, gen, coordinates);
+    CompactFringeGraph graph;
+    Workload workload = buildCompactGraph("road", side * side, edges, graph);
+    workload.queries = generateQueries(options, workload.nodes, gen);
+
+    runCompactEngines(options, workload, graph, "euclid", EuclideanHeuristic(coordinates), 0);
+    runContractionHierarchy(options, workload, graph);
+}
+
+void benchmarkDimacs(const Options& options) {
+    std::ifstream in(options.dimacs, std::ios::binary);
+    GraphBuilder builder;
+
+    bench_clock::time_point start = bench_clock::now();
+    if (!GraphImporter().readDimacsGraph(in, builder)) {
+        std::fprintf(stderr, "Could not read %s\n", options.dimacs.c_str());
+        std::exit(1);
+    }
+    CompactFringeGraph graph;
+    Workload workload = buildCompactGraph("dimacs", builder.getNodeCount(), builder.getEdges(), graph);
+    workload.buildMilliseconds = millisecondsSince(start);
+
+    std::mt19937 gen(options.seed);
+    workload.queries = generateQueries(options, workload.nodes, gen);
+    runLandmarkEngines(options, workload, graph);
+    runContractionHierarchy(options, workload, graph);
+
+    // The same queries on the graph renumbered for locality, files often list nodes in no useful order
+    start = bench_clock::now();
+    NodeOrder order = NodeOrder::reverseCuthillMcKee(graph);
+    CompactFringeGraph reorderedGraph = order.apply(graph);
+    Workload reordered = workload;
+    reordered.name = "dimacs-rcm";
+    reordered.prepMilliseconds = millisecondsSince(start);
+    reordered.bytes = sizeof(reorderedGraph) + reorderedGraph.getAllocatedBytes();
+    for (query_t& query : reordered.queries) {
+        query = query_t(order.getReorderedIndex(query.first), order.getReorderedIndex(query.second));
+    }
+    runLandmarkEngines(options, reordered, reorderedGraph);
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    options.graphs = "grid,er,scalefree,road";
+    options.minNodes = 10000;
+    options.maxNodes = 100000;
+    options.queries = 100;
+    options.timeLimit = 10;
+    options.seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 == argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(argv[i - 1], "--graphs") == 0) {
+            options.graphs = value;
+        } else if (std::strcmp(argv[i - 1], "--min-nodes") == 0) {
+            options.minNodes = static_cast<node_id_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(argv[i - 1], "--max-nodes") == 0) {
+            options.maxNodes = static_cast<node_id_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(argv[i - 1], "--queries") == 0) {
+            options.queries = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(argv[i - 1], "--time-limit") == 0) {
+            options.timeLimit = std::strtod(value, nullptr);
+        } else if (std::strcmp(argv[i - 1], "--seed") == 0) {
+            options.seed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(argv[i - 1], "--dimacs") == 0) {
+            options.dimacs = value;
+        } else if (std::strcmp(argv[i - 1], "--map") == 0) {
+            options.map = value;
+        } else if (std::strcmp(argv[i - 1], "--scen") == 0) {
+            options.scenarios = value;
+        } else {
+            return false;
+        }
+    }
+    return options.minNodes >= 10 && options.minNodes <= options.maxNodes && options.queries > 0
+           && options.map.empty() == options.scenarios.empty();
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [--graphs grid,er,scalefree,road] [--min-nodes N] [--max-nodes N] "
+                             "[--queries N] [--time-limit S] [--seed N] [--dimacs FILE.gr] "
+                             "[--map FILE.map --scen FILE.scen]\n", argv[0]);
+        return 1;
+    }
+
+    printHeader();
+    if (!options.dimacs.empty()) {
+        benchmarkDimacs(options);
+    }
+    if (!options.map.empty()) {
+        benchmarkMovingAI(options);
+    }
+    for (uint64_t nodes = options.minNodes; nodes <= options.maxNodes; nodes *= 10) {
+        std::string graphs = "," + options.graphs + ",";
+        node_id_t n = static_cast<node_id_t>(nodes);
+        if (graphs.find(",grid,") != std::string::npos) {
+            benchmarkGrid(options, n);
+        }
+        if (graphs.find(",er,") != std::string::npos) {
+            benchmarkErdosRenyi(options, n);
+        }
+        if (graphs.find(",scalefree,") != std::string::npos) {
+            benchmarkScaleFree(options, n);
+        }
+        if (graphs.find(",road,") != std::string::npos) {
+            benchmarkRoad(options, n);
+        }
+    }
+    return 0;
+}
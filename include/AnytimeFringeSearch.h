@@ -0,0 +1,146 @@
+#ifndef USER_EQUILIBRIUM_ANYTIMEFRINGESEARCH_H
+#define USER_EQUILIBRIUM_ANYTIMEFRINGESEARCH_H
+
+#include <chrono>
+#include <limits>
+#include <utility>
+
+#include "FringeSearchT.h"
+
+/**
+ * Anytime fringe search that returns a first path quickly and improves it until a deadline.
+ *
+ * The first search inflates the heuristic by the initial weight. While time is
+ * left, the search is restarted with the excess weight over 1 halved, keeping
+ * the cheapest path found, until a search with weight 1 found the optimal path.
+ * A search that was started is always finished, so a new search is only
+ * started if the previous one took less time than is left until the deadline.
+ *
+ * The heuristic must be admissible for the bounds to hold.
+ *
+ * @tparam Graph The graph type
+ * @tparam Heuristic The heuristic policy
+ * @tparam Weight The weight policy
+ * @tparam Fringe The fringe implementation
+ * @tparam Context The search context layout, BasicSearchContext or ColumnarSearchContext
+ */
+template <class Graph, class Heuristic = ZeroHeuristic, class Weight = DefaultWeight,
+        template <class> class Fringe = LinkedFringe, template <class, class> class Context = BasicSearchContext>
+class AnytimeFringeSearchT {
+public:
+    typedef typename Graph::node_t node_t;
+    typedef FringeSearchT<Graph, WeightedHeuristic<Heuristic>, Weight, Fringe, Context> search_t;
+    typedef std::chrono::steady_clock::time_point time_point_t;
+
+private:
+    // Weights closer to 1 than this are rounded to 1
+    static constexpr edge_weight_t MIN_EXCESS_WEIGHT = 0.01f;
+
+    search_t engine;
+
+    Heuristic heuristic;
+
+    // The weight of the first search
+    edge_weight_t initialWeight;
+
+    // The cost of the best path found by the last call to search()
+    edge_weight_t bestCost;
+
+    // The factor the best path costs at most more than the optimal path
+    edge_weight_t bound;
+
+    // The path of the current search, swapped with the best path when it is cheaper
+    PathBuffer<Graph> candidate;
+
+public:
+    /**
+     * Create an anytime fringe search instance, but do not initialize.
+     *
+     * Call reset() before calling search().
+     *
+     * @param graph The graph to search, must outlive this search
+     * @param initialWeight The heuristic weight of the first search, at least 1
+     * @param heuristic The heuristic function, must be admissible
+     * @param weight The weight function
+     */
+    AnytimeFringeSearchT(const Graph& graph, edge_weight_t initialWeight = 2, const Heuristic& heuristic = Heuristic(),
+                         const Weight& weight = Weight())
+            : engine(graph, WeightedHeuristic<Heuristic>(initialWeight, heuristic), weight), heuristic(heuristic),
+              initialWeight(initialWeight), bestCost(std::numeric_limits<edge_weight_t>::infinity()), bound(0) {}
+
+    /**
+     * Search for a target node, improving the path until the deadline.
+     *
+     * @param end The target node
+     * @param path The buffer to store the best path from start to end in, cleared if no path was found
+     * @param deadline The time after which no new search is started
+     * @return True if a path was found
+     */
+    bool search(node_t end, PathBuffer<Graph>& path, time_point_t deadline);
+
+    /**
+     * Get the cost of the path found by the last search.
+     *
+     * @return The cost of the path, or infinity if no path was found
+     */
+    edge_weight_t cost() const {
+        return bestCost;
+    }
+
+    /**
+     * Get the suboptimality bound of the path found by the last search.
+     *
+     * @return The factor the path costs at most more than the optimal path, 1 if it is optimal
+     */
+    edge_weight_t getBound() const {
+        return bound;
+    }
+
+    /**
+     * Reset the search so a search with a different starting node can start
+     *
+     * @param start The new starting node
+     */
+    void reset(node_t start) {
+        engine.reset(start);
+    }
+};
+
+template <class Graph, class Heuristic, class Weight, template <class> class Fringe,
+        template <class, class> class Context>
+bool AnytimeFringeSearchT<Graph, Heuristic, Weight, Fringe, Context>::search(node_t end, PathBuffer<Graph>& path,
+                                                                             time_point_t deadline) {
+    bestCost = std::numeric_limits<edge_weight_t>::infinity();
+    bound = 0;
+
+    edge_weight_t factor = initialWeight;
+    while (true) {
+        time_point_t searchStart = std::chrono::steady_clock::now();
+        engine.setHeuristic(WeightedHeuristic<Heuristic>(factor, heuristic));
+        if (!engine.search(end, candidate)) {
+            // Inflating the heuristic does not change which nodes are reachable
+            path.nodes.clear();
+            path.edges.clear();
+            return false;
+        }
+
+        edge_weight_t candidateCost = engine.cost(end);
+        if (candidateCost < bestCost) {
+            bestCost = candidateCost;
+            std::swap(path, candidate);
+        }
+        bound = factor;
+
+        time_point_t searchEnd = std::chrono::steady_clock::now();
+        if (factor == 1 || searchEnd + (searchEnd - searchStart) > deadline) {
+            return true;
+        }
+
+        factor = 1 + (factor - 1) / 2;
+        if (factor - 1 < MIN_EXCESS_WEIGHT) {
+            factor = 1;
+        }
+    }
+}
+
+#endif //USER_EQUILIBRIUM_ANYTIMEFRINGESEARCH_H
@@ -0,0 +1,418 @@
+#ifndef USER_EQUILIBRIUM_BIDIRECTIONALFRINGESEARCH_H
+#define USER_EQUILIBRIUM_BIDIRECTIONALFRINGESEARCH_H
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "FringeGraph.h"
+#include "FringeLists.h"
+#include "FringeSearchPolicies.h"
+#include "FringeSearchT.h"
+#include "SearchContext.h"
+
+/**
+ * Bidirectional implementation of the fringe search algorithm.
+ *
+ * One fringe expands forward from the start node over outgoing edges, the other
+ * expands backward from the end node over incoming edges. Besides the members
+ * used by FringeSearchT, the graph type provides an incoming_iterator type and
+ * the members getFirstIncoming(node), getLastIncoming(node),
+ * getIncomingEdge(iterator) and getSource(edge).
+ *
+ * Both directions search on edge weights reduced by the average potential
+ * p(n) = (h(n, end) - h(start, n)) / 2, so each threshold is a lower bound on
+ * the cost of all nodes that were not yet expanded with their final cost in that
+ * direction. The direction with the lowest threshold runs the next iteration,
+ * and the search stops once the best path connecting both directions costs no
+ * more than the sum of both thresholds. This requires a consistent heuristic.
+ * Weights are calculated with a costToFrom of 0, as the cost to reach an edge is
+ * not known when searching backward.
+ *
+ * @tparam Graph The graph type
+ * @tparam Heuristic The heuristic policy
+ * @tparam Weight The weight policy
+ * @tparam Fringe The fringe implementation
+ * @tparam Context The search context layout, BasicSearchContext or ColumnarSearchContext
+ */
+template <class Graph, class Heuristic = ZeroHeuristic, class Weight = DefaultWeight,
+        template <class> class Fringe = LinkedFringe, template <class, class> class Context = BasicSearchContext>
+class BidirectionalFringeSearchT {
+public:
+    typedef typename Graph::node_t node_t;
+    typedef typename Graph::edge_t edge_t;
+    typedef typename Graph::edge_iterator edge_iterator;
+    typedef typename Graph::incoming_iterator incoming_iterator;
+    typedef Context<node_t, edge_t> context_t;
+
+private:
+    // Maps nodes to their search data for the fringe
+    struct DataAccess {
+        typedef typename context_t::reference reference;
+
+        const Graph& graph;
+        context_t& context;
+
+        reference operator()(node_t node) const {
+            return context[graph.getIndex(node)];
+        }
+    };
+
+    // The state of one search direction, the cached heuristic of its nodes holds their potential
+    struct Direction {
+        // The context owned by this direction if none was given
+        std::unique_ptr<context_t> ownedContext;
+
+        // The search data of this direction
+        context_t* context;
+
+        Fringe<node_t> fringe;
+
+        // The threshold of the next iteration
+        edge_weight_t limit;
+    };
+
+    const Graph& graph;
+
+    Heuristic heuristic;
+
+    Weight weight;
+
+    Direction forward;
+
+    Direction backward;
+
+    // The search' starting node
+    node_t start;
+
+    // The search' target node
+    node_t end;
+
+    // The reduced cost of the best path found so far
+    edge_weight_t best;
+
+    // The cost of the best path found by the last search, infinite if it found none
+    edge_weight_t bestCost;
+
+    // The edge connecting the forward and backward halves of the best path
+    node_t meetFrom;
+    node_t meetTo;
+    edge_t meetEdge;
+
+public:
+    /**
+     * Create a bidirectional fringe search instance, but do not initialize.
+     *
+     * Call reset() before calling search().
+     *
+     * @param graph The graph to search, must outlive this search
+     * @param heuristic The heuristic function
+     * @param weight The weight function
+     */
+    BidirectionalFringeSearchT(const Graph& graph, const Heuristic& heuristic = Heuristic(),
+                               const Weight& weight = Weight())
+            : graph(graph), heuristic(heuristic), weight(weight), start(SearchNodeTraits<node_t>::none()),
+              end(SearchNodeTraits<node_t>::none()), bestCost(std::numeric_limits<edge_weight_t>::infinity()) {
+        forward.ownedContext.reset(new context_t(graph.getNodeCount()));
+        forward.context = forward.ownedContext.get();
+        backward.ownedContext.reset(new context_t(graph.getNodeCount()));
+        backward.context = backward.ownedContext.get();
+    }
+
+    /**
+     * Create a bidirectional fringe search instance using the given contexts, but do not initialize.
+     *
+     * Call reset() before calling search().
+     *
+     * @param graph The graph to search, must outlive this search
+     * @param forwardContext The context to store forward search data in, must outlive this search
+     * @param backwardContext The context to store backward search data in, must outlive this search
+     * @param heuristic The heuristic function
+     * @param weight The weight function
+     */
+    BidirectionalFringeSearchT(const Graph& graph, context_t& forwardContext, context_t& backwardContext,
+                               const Heuristic& heuristic = Heuristic(), const Weight& weight = Weight())
+            : graph(graph), heuristic(heuristic), weight(weight), start(SearchNodeTraits<node_t>::none()),
+              end(SearchNodeTraits<node_t>::none()), bestCost(std::numeric_limits<edge_weight_t>::infinity()) {
+        forward.context = &forwardContext;
+        forward.context->reserve(graph.getNodeCount());
+        backward.context = &backwardContext;
+        backward.context->reserve(graph.getNodeCount());
+    }
+
+    /**
+     * Search for a target node.
+     *
+     * @param end The target node.
+     * @return The nodes to visit excluding start, including end, in reverse order
+     */
+    std::vector<node_t>* search(node_t end);
+
+    /**
+     * Search for a target node and store the path in a reusable buffer.
+     *
+     * @param end The target node
+     * @param path The buffer to store the path from start to end in, cleared if no path was found
+     * @return True if a path was found
+     */
+    bool search(node_t end, PathBuffer<Graph>& path) {
+        if (!run(end)) {
+            path.nodes.clear();
+            path.edges.clear();
+            return false;
+        }
+        writePath(path);
+        return true;
+    }
+
+    /**
+     * Get the path found by the last search and store it in a reusable buffer.
+     *
+     * @param path The buffer to store the path from start to end in, cleared if the last search found no path
+     * @return True if the last search found a path
+     */
+    bool path(PathBuffer<Graph>& path) const {
+        if (bestCost == std::numeric_limits<edge_weight_t>::infinity()) {
+            path.nodes.clear();
+            path.edges.clear();
+            return false;
+        }
+        writePath(path);
+        return true;
+    }
+
+    /**
+     * Get the cost to the given target node.
+     *
+     * Call search() before calling this.
+     *
+     * @param end The target node passed to the last search
+     * @return cost The cost of the path, or infinity if the last search found none or was for another node
+     */
+    edge_weight_t cost(node_t end) const {
+        return end == this->end ? bestCost : std::numeric_limits<edge_weight_t>::infinity();
+    }
+
+    /**
+     * Reset the search so a search with a different starting node can start
+     *
+     * @param start The new starting node
+     */
+    void reset(node_t start) {
+        this->start = start;
+    }
+
+private:
+    // Search for a target node, leaving the cost in bestCost
+    bool run(node_t end);
+
+    void writePath(PathBuffer<Graph>& path) const;
+
+    edge_weight_t potential(node_t node) const {
+        return (heuristic(graph, node, end) - heuristic(graph, start, node)) / 2;
+    }
+
+    void initialize(Direction& direction, node_t node) {
+        direction.context->begin();
+        direction.context->initialize(graph.getIndex(node)).h = potential(node);
+
+        DataAccess data = {graph, *direction.context};
+        direction.fringe.reset(data, node);
+        direction.limit = 0;
+    }
+
+    void iterate(Direction& self, Direction& other, bool isForward);
+
+    void relax(Direction& self, Direction& other, bool isForward, node_t current, edge_weight_t currentG,
+               edge_weight_t currentP, edge_t edge, node_t next);
+};
+
+template <class Graph, class Heuristic, class Weight, template <class> class Fringe,
+        template <class, class> class Context>
+std::vector<typename Graph::node_t>* BidirectionalFringeSearchT<Graph, Heuristic, Weight, Fringe, Context>::search(
+        node_t end) {
+    if (!run(end)) {
+        return nullptr;
+    }
+    if (start == end) {
+        return new std::vector<node_t>();
+    }
+
+    // The backward search reached every node by the edge towards the end node
+    std::vector<node_t> backwardPath;
+    for (node_t current = meetTo; current != end;
+         current = graph.getTarget((*backward.context)[graph.getIndex(current)].previousEdge)) {
+        backwardPath.push_back(current);
+    }
+    backwardPath.push_back(end);
+
+    std::vector<node_t>* result = new std::vector<node_t>(backwardPath.rbegin(), backwardPath.rend());
+    for (node_t current = meetFrom; current != start;
+         current = graph.getSource((*forward.context)[graph.getIndex(current)].previousEdge)) {
+        result->push_back(current);
+    }
+    return result;
+}
+
+template <class Graph, class Heuristic, class Weight, template <class> class Fringe,
+        template <class, class> class Context>
+bool BidirectionalFringeSearchT<Graph, Heuristic, Weight, Fringe, Context>::run(node_t end) {
+    this->end = end;
+    bestCost = std::numeric_limits<edge_weight_t>::infinity();
+
+    if (start == end) {
+        bestCost = 0;
+        return true;
+    }
+
+    initialize(forward, start);
+    initialize(backward, end);
+    best = std::numeric_limits<edge_weight_t>::infinity();
+
+    // Once a direction runs out of nodes its threshold is infinite and the search stops
+    while (best > forward.limit + backward.limit) {
+        if (forward.limit <= backward.limit) {
+            iterate(forward, backward, true);
+        } else {
+            iterate(backward, forward, false);
+        }
+    }
+
+    if (best == std::numeric_limits<edge_weight_t>::infinity()) {
+        return false;
+    }
+
+    // Undo the potentials of the start and end node
+    bestCost = best + (*forward.context)[graph.getIndex(start)].h - (*backward.context)[graph.getIndex(end)].h;
+    return true;
+}
+
+template <class Graph, class Heuristic, class Weight, template <class> class Fringe,
+        template <class, class> class Context>
+void BidirectionalFringeSearchT<Graph, Heuristic, Weight, Fringe, Context>::writePath(PathBuffer<Graph>& path) const {
+    path.nodes.clear();
+    path.edges.clear();
+    if (start == end) {
+        path.nodes.push_back(start);
+        return;
+    }
+
+    // The forward search reached every node by the edge from the start node, so its half is collected in reverse
+    for (node_t current = meetFrom; current != start;) {
+        edge_t edge = (*forward.context)[graph.getIndex(current)].previousEdge;
+        path.nodes.push_back(current);
+        path.edges.push_back(edge);
+        current = graph.getSource(edge);
+    }
+    path.nodes.push_back(start);
+    std::reverse(path.nodes.begin(), path.nodes.end());
+    std::reverse(path.edges.begin(), path.edges.end());
+
+    path.edges.push_back(meetEdge);
+    for (node_t current = meetTo; current != end;) {
+        edge_t edge = (*backward.context)[graph.getIndex(current)].previousEdge;
+        path.nodes.push_back(current);
+        path.edges.push_back(edge);
+        current = graph.getTarget(edge);
+    }
+    path.nodes.push_back(end);
+}
+
+template <class Graph, class Heuristic, class Weight, template <class> class Fringe,
+        template <class, class> class Context>
+void BidirectionalFringeSearchT<Graph, Heuristic, Weight, Fringe, Context>::iterate(Direction& self,
+                                                                                    Direction& other,
+                                                                                    bool isForward) {
+    const node_t none = SearchNodeTraits<node_t>::none();
+    DataAccess data = {graph, *self.context};
+
+    edge_weight_t minF = std::numeric_limits<edge_weight_t>::infinity();
+
+    node_t current = self.fringe.first(data);
+    while (current != none) {
+        typename context_t::reference currentData = data(current);
+        edge_weight_t currentG = currentData.g;
+
+        if (currentG > self.limit) {
+            if (currentG < minF) {
+                minF = currentG;
+            }
+            current = self.fringe.defer(data, current);
+            continue;
+        }
+
+        // Expand children
+        edge_weight_t currentP = currentData.h;
+        if (isForward) {
+            edge_iterator last = graph.getLastOutgoing(current);
+            for (edge_iterator it = graph.getFirstOutgoing(current); it != last; ++it) {
+                edge_t edge = graph.getEdge(it);
+                relax(self, other, true, current, currentG, currentP, edge, graph.getTarget(edge));
+            }
+        } else {
+            incoming_iterator last = graph.getLastIncoming(current);
+            for (incoming_iterator it = graph.getFirstIncoming(current); it != last; ++it) {
+                edge_t edge = graph.getIncomingEdge(it);
+                relax(self, other, false, current, currentG, currentP, edge, graph.getSource(edge));
+            }
+        }
+
+        current = self.fringe.expand(data, current);
+    }
+
+    self.fringe.endIteration(data);
+    self.limit = minF;
+}
+
+template <class Graph, class Heuristic, class Weight, template <class> class Fringe,
+        template <class, class> class Context>
+void BidirectionalFringeSearchT<Graph, Heuristic, Weight, Fringe, Context>::relax(Direction& self,
+                                                                                  Direction& other,
+                                                                                  bool isForward, node_t current,
+                                                                                  edge_weight_t currentG,
+                                                                                  edge_weight_t currentP,
+                                                                                  edge_t edge, node_t next) {
+    context_t& context = *self.context;
+    node_id_t nextIndex = graph.getIndex(next);
+
+    bool reached = context.contains(nextIndex);
+    edge_weight_t nextP = reached ? context[nextIndex].h : potential(next);
+
+    // Reduce the weight with the potentials of both nodes, in the direction of the edge
+    edge_weight_t reducedWeight = weight(graph, edge, 0);
+    if (isForward) {
+        reducedWeight += nextP - currentP;
+    } else {
+        reducedWeight += currentP - nextP;
+    }
+    edge_weight_t g = currentG + reducedWeight;
+
+    // Check if this edge connects both directions with a better path
+    if (other.context->contains(nextIndex)) {
+        edge_weight_t total = g + (*other.context)[nextIndex].g;
+        if (total < best) {
+            best = total;
+            meetFrom = isForward ? current : next;
+            meetTo = isForward ? next : current;
+            meetEdge = edge;
+        }
+    }
+
+    // Do not consider the child if a better route already exists
+    if (reached) {
+        if (g > context[nextIndex].g) {
+            return;
+        }
+    } else {
+        context.initialize(nextIndex).h = nextP;
+    }
+    typename context_t::reference nextData = context[nextIndex];
+    nextData.previousEdge = edge;
+    nextData.g = g;
+
+    DataAccess data = {graph, context};
+    self.fringe.add(data, next);
+}
+
+#endif //USER_EQUILIBRIUM_BIDIRECTIONALFRINGESEARCH_H
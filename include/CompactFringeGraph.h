@@ -0,0 +1,243 @@
+#ifndef USER_EQUILIBRIUM_COMPACTFRINGEGRAPH_H
+#define USER_EQUILIBRIUM_COMPACTFRINGEGRAPH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "FringeGraph.h"
+
+/**
+ * An edge in a raw edge list, used to build a CompactFringeGraph.
+ */
+struct CompactFringeEdge {
+    node_id_t from;
+    node_id_t to;
+    edge_weight_t weight;
+};
+
+/**
+ * An immutable graph in compressed sparse row (CSR) format.
+ *
+ * Nodes are identified by their index in [0, getNodeCount()). The outgoing
+ * edges of node n are the edge IDs in [getFirstOutgoing(n), getLastOutgoing(n)),
+ * their targets and weights are stored in two contiguous arrays so traversing
+ * the graph does not have to chase any pointers. Incoming edges are stored the
+ * same way, as forward edge IDs grouped by target node.
+ *
+ * Can be searched with FringeSearchT, see CompactFringeSearch.
+ */
+class CompactFringeGraph {
+
+    // For every node, the index of its first outgoing edge, with one extra trailing entry
+    std::vector<edge_id_t> offsets;
+
+    // The target node of every edge
+    std::vector<node_id_t> targets;
+
+    // The weight of every edge
+    std::vector<edge_weight_t> weights;
+
+    // The source node of every edge
+    std::vector<node_id_t> sources;
+
+    // For every node, the position of its first incoming edge in incomingEdges, with one extra trailing entry
+    std::vector<edge_id_t> incomingOffsets;
+
+    // The IDs of all edges, grouped by target node
+    std::vector<edge_id_t> incomingEdges;
+
+    // The nodes this graph was built from, empty if built from an edge list
+    std::vector<BaseFringeNode*> sourceNodes;
+
+    // The edges this graph was built from, empty if built from an edge list
+    std::vector<BaseFringeEdge*> sourceEdges;
+
+public:
+    typedef node_id_t node_t;
+    typedef edge_id_t edge_t;
+    typedef edge_id_t edge_iterator;
+    typedef const edge_id_t* incoming_iterator;
+
+    /**
+     * Create an empty graph.
+     */
+    CompactFringeGraph();
+
+    /**
+     * Build a graph from a raw edge list.
+     *
+     * Edges keep their relative order within the outgoing edges of a node.
+     *
+     * @param nodeCount The number of nodes, all edge endpoints must be smaller than this
+     * @param edges The edges
+     */
+    CompactFringeGraph(node_id_t nodeCount, const std::vector<CompactFringeEdge>& edges);
+
+    /**
+     * Build a graph from a set of nodes and their outgoing edges.
+     *
+     * The node at position i in nodes gets index i in the compact graph.
+     * Edges to nodes that are not in the set are left out. Edges are
+     * stored with their default weight, as returned by BaseFringeEdge::getWeight().
+     *
+     * @param nodes The nodes
+     */
+    CompactFringeGraph(const std::vector<BaseFringeNode*>& nodes);
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return The number of nodes
+     */
+    node_id_t getNodeCount() const {
+        return static_cast<node_id_t>(offsets.size() - 1);
+    }
+
+    /**
+     * Get the number of edges.
+     *
+     * @return The number of edges
+     */
+    edge_id_t getEdgeCount() const {
+        return static_cast<edge_id_t>(targets.size());
+    }
+
+    /**
+     * Get the number of bytes allocated for the graph's arrays.
+     *
+     * @return The number of bytes
+     */
+    std::size_t getAllocatedBytes() const;
+
+    /**
+     * Get the index of a node in a search context.
+     *
+     * @param node The node
+     * @return The node itself
+     */
+    node_id_t getIndex(node_id_t node) const {
+        return node;
+    }
+
+    /**
+     * Get the ID of the first outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The first outgoing edge
+     */
+    edge_id_t getFirstOutgoing(node_id_t node) const {
+        return offsets[node];
+    }
+
+    /**
+     * Get the ID one past the last outgoing edge of a node.
+     *
+     * @param node The node
+     * @return One past the last outgoing edge
+     */
+    edge_id_t getLastOutgoing(node_id_t node) const {
+        return offsets[node + 1];
+    }
+
+    /**
+     * Get the edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge ID, which is the iterator itself
+     */
+    edge_id_t getEdge(edge_id_t it) const {
+        return it;
+    }
+
+    /**
+     * Get an iterator to the first incoming edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getFirstIncoming(node_id_t node) const {
+        return incomingEdges.data() + incomingOffsets[node];
+    }
+
+    /**
+     * Get an iterator one past the last incoming edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getLastIncoming(node_id_t node) const {
+        return incomingEdges.data() + incomingOffsets[node + 1];
+    }
+
+    /**
+     * Get the incoming edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge ID
+     */
+    edge_id_t getIncomingEdge(incoming_iterator it) const {
+        return *it;
+    }
+
+    /**
+     * Get the source node of an edge.
+     *
+     * @param edge The edge
+     * @return The source node
+     */
+    node_id_t getSource(edge_id_t edge) const {
+        return sources[edge];
+    }
+
+    /**
+     * Get the target node of an edge.
+     *
+     * @param edge The edge
+     * @return The target node
+     */
+    node_id_t getTarget(edge_id_t edge) const {
+        return targets[edge];
+    }
+
+    /**
+     * Get the weight of an edge.
+     *
+     * @param edge The edge
+     * @return The weight
+     */
+    edge_weight_t getWeight(edge_id_t edge) const {
+        return weights[edge];
+    }
+
+    /**
+     * Get the node this graph's node was built from.
+     *
+     * @param node The node index
+     * @return The original node, or nullptr if the graph was built from an edge list
+     */
+    BaseFringeNode* getSourceNode(node_id_t node) const;
+
+    /**
+     * Get the edge this graph's edge was built from.
+     *
+     * @param edge The edge ID
+     * @return The original edge, or nullptr if the graph was built from an edge list
+     */
+    BaseFringeEdge* getSourceEdge(edge_id_t edge) const;
+
+    /**
+     * Build a copy of this graph with renumbered nodes, see NodeOrder.
+     *
+     * Edges are renumbered to stay grouped by source node, keeping their relative
+     * order. The source nodes and edges of the copy are those of this graph.
+     *
+     * @param order The index in this graph of every node of the copy, a permutation of all nodes
+     * @return The renumbered graph
+     */
+    CompactFringeGraph reorder(const std::vector<node_id_t>& order) const;
+
+private:
+    void build(node_id_t nodeCount, const std::vector<CompactFringeEdge>& edges);
+};
+
+#endif //USER_EQUILIBRIUM_COMPACTFRINGEGRAPH_H
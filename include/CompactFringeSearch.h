@@ -0,0 +1,15 @@
+#ifndef USER_EQUILIBRIUM_COMPACTFRINGESEARCH_H
+#define USER_EQUILIBRIUM_COMPACTFRINGESEARCH_H
+
+#include "CompactFringeGraph.h"
+#include "FringeSearchT.h"
+
+/**
+ * Fringe search on a CompactFringeGraph.
+ *
+ * Search data is kept in a CompactSearchContext indexed by node, so expanding
+ * a node only reads the graph's contiguous edge arrays and the context.
+ */
+typedef FringeSearchT<CompactFringeGraph> CompactFringeSearch;
+
+#endif //USER_EQUILIBRIUM_COMPACTFRINGESEARCH_H
@@ -0,0 +1,291 @@
+#ifndef USER_EQUILIBRIUM_CONTRACTIONHIERARCHY_H
+#define USER_EQUILIBRIUM_CONTRACTIONHIERARCHY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "CompactFringeGraph.h"
+#include "FringeGraph.h"
+
+/**
+ * A contraction hierarchy for fast shortest path queries on a static graph.
+ *
+ * Preprocessing contracts nodes one by one in order of importance. Contracting
+ * a node removes it from the remaining graph and adds a shortcut between two of
+ * its neighbours whenever a witness search finds no shorter path between them
+ * without the node. A query then only has to follow edges
+ * towards more important nodes from both ends, see ContractionHierarchyQuery.
+ *
+ * Nodes are ordered by edge difference (shortcuts added minus edges removed)
+ * plus the number of contracted neighbours. Every round contracts a set of
+ * nodes that are less important than all of their neighbours in parallel.
+ *
+ * Nodes and original edges are identified by their index in the
+ * CompactFringeGraph the hierarchy was built from.
+ */
+class ContractionHierarchy {
+public:
+    /**
+     * An edge of the hierarchy, either an original edge or a shortcut over two hierarchy edges.
+     */
+    struct Edge {
+        node_id_t from;
+        node_id_t to;
+        edge_weight_t weight;
+        // The original edge ID, or the hierarchy edge from from to the contracted node for shortcuts
+        edge_id_t first;
+        // NO_EDGE for original edges, or the hierarchy edge from the contracted node to to for shortcuts
+        edge_id_t second;
+    };
+
+    // Marks the absence of an edge
+    static const edge_id_t NO_EDGE = UINT32_MAX;
+
+private:
+    // The contraction order of every node, higher is more important
+    std::vector<node_id_t> ranks;
+
+    // All original edges followed by all shortcuts
+    std::vector<Edge> edges;
+
+    // For every node, the position of its first upward outgoing edge in upEdges, with one extra trailing entry
+    std::vector<edge_id_t> upOffsets;
+
+    // The hierarchy edges from every node to more important nodes, grouped by source node
+    std::vector<edge_id_t> upEdges;
+
+    // For every node, the position of its first upward incoming edge in downEdges, with one extra trailing entry
+    std::vector<edge_id_t> downOffsets;
+
+    // The hierarchy edges to every node from more important nodes, grouped by target node
+    std::vector<edge_id_t> downEdges;
+
+public:
+    /**
+     * Create an empty hierarchy, to load().
+     */
+    ContractionHierarchy();
+
+    /**
+     * Contract all nodes of a graph.
+     *
+     * @param graph The graph
+     * @param threadCount The number of threads, 0 to use one per hardware thread
+     * @param witnessLimit The maximum number of nodes a single witness search settles,
+     *                     lower limits speed up preprocessing but add unnecessary shortcuts
+     */
+    ContractionHierarchy(const CompactFringeGraph& graph, unsigned int threadCount = 0,
+                         std::size_t witnessLimit = 500);
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return The number of nodes
+     */
+    node_id_t getNodeCount() const {
+        return static_cast<node_id_t>(ranks.size());
+    }
+
+    /**
+     * Get the number of shortcuts added.
+     *
+     * @return The number of shortcuts
+     */
+    std::size_t getShortcutCount() const;
+
+    /**
+     * Get the contraction order of a node.
+     *
+     * @param node The node
+     * @return The rank of the node, higher is more important
+     */
+    node_id_t getRank(node_id_t node) const {
+        return ranks[node];
+    }
+
+    /**
+     * Get a hierarchy edge.
+     *
+     * @param edge The hierarchy edge ID
+     * @return The edge
+     */
+    const Edge& getEdge(edge_id_t edge) const {
+        return edges[edge];
+    }
+
+    /**
+     * Get the position of the first upward outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The position in getUpEdges()
+     */
+    edge_id_t getFirstUp(node_id_t node) const {
+        return upOffsets[node];
+    }
+
+    /**
+     * Get the position one past the last upward outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The position in getUpEdges()
+     */
+    edge_id_t getLastUp(node_id_t node) const {
+        return upOffsets[node + 1];
+    }
+
+    /**
+     * Get the hierarchy edge at a position of the upward outgoing edges.
+     *
+     * @param position The position
+     * @return The hierarchy edge ID
+     */
+    edge_id_t getUpEdge(edge_id_t position) const {
+        return upEdges[position];
+    }
+
+    /**
+     * Get the position of the first upward incoming edge of a node, coming from a more important node.
+     *
+     * @param node The node
+     * @return The position in getDownEdges()
+     */
+    edge_id_t getFirstDown(node_id_t node) const {
+        return downOffsets[node];
+    }
+
+    /**
+     * Get the position one past the last upward incoming edge of a node.
+     *
+     * @param node The node
+     * @return The position in getDownEdges()
+     */
+    edge_id_t getLastDown(node_id_t node) const {
+        return downOffsets[node + 1];
+    }
+
+    /**
+     * Get the hierarchy edge at a position of the upward incoming edges.
+     *
+     * @param position The position
+     * @return The hierarchy edge ID
+     */
+    edge_id_t getDownEdge(edge_id_t position) const {
+        return downEdges[position];
+    }
+
+    /**
+     * Append the original edges a hierarchy edge stands for.
+     *
+     * @param edge The hierarchy edge ID
+     * @param result The vector to append the original edge IDs to, in order
+     */
+    void unpack(edge_id_t edge, std::vector<edge_id_t>& result) const;
+
+    /**
+     * Write this hierarchy in a binary format.
+     *
+     * @param out The stream to write to
+     * @return True if writing succeeded
+     */
+    bool save(std::ostream& out) const;
+
+    /**
+     * Replace this hierarchy by one written with save().
+     *
+     * Files written on a machine with a different byte order are rejected, and
+     * all node and edge indices are checked. The original edge IDs cannot be
+     * checked without the graph, so only unpack paths with the graph the
+     * hierarchy was built from.
+     *
+     * @param in The stream to read from
+     * @return True if reading succeeded, otherwise this hierarchy is left empty
+     */
+    bool load(std::istream& in);
+
+private:
+    // Build the upward adjacency arrays from the edges left when the lower ranked endpoint was contracted
+    void buildSearchGraph(const std::vector<edge_id_t>& hierarchyEdges);
+};
+
+/**
+ * A shortest path query on a ContractionHierarchy.
+ *
+ * Runs a Dijkstra search upward from the start node and one upward from the
+ * end node over incoming edges, and stops once neither can improve the best
+ * meeting node. A query keeps its search data between searches, with the same
+ * generation stamps as BasicSearchContext, so use one query per thread.
+ */
+class ContractionHierarchyQuery {
+
+    struct Direction {
+        std::vector<edge_weight_t> distances;
+        // The hierarchy edge every node was reached by
+        std::vector<edge_id_t> previousEdges;
+        std::vector<uint32_t> generations;
+        // Binary heap of nodes to settle, ordered by distance, may contain outdated entries
+        std::vector<std::pair<edge_weight_t, node_id_t>> queue;
+    };
+
+    const ContractionHierarchy& hierarchy;
+
+    Direction forward;
+
+    Direction backward;
+
+    // The generation of the current search
+    uint32_t generation;
+
+    // The node where both searches met on the best path, or UINT32_MAX if no path was found
+    node_id_t meeting;
+
+    // The cost of the best path
+    edge_weight_t best;
+
+public:
+    /**
+     * Create a query.
+     *
+     * @param hierarchy The hierarchy to search, must outlive this query
+     */
+    ContractionHierarchyQuery(const ContractionHierarchy& hierarchy);
+
+    /**
+     * Search for the cost between two nodes.
+     *
+     * @param start The start node
+     * @param end The target node
+     * @return The cost of the shortest path, or infinity if there is no path
+     */
+    edge_weight_t search(node_id_t start, node_id_t end);
+
+    /**
+     * Get the original edges on the path found by the last search.
+     *
+     * @param result Receives the original edge IDs from start to end, cleared if no path was found
+     * @return True if a path was found
+     */
+    bool path(std::vector<edge_id_t>& result) const;
+
+    /**
+     * Get the edges on the path found by the last search as the edges the graph was built from.
+     *
+     * @param graph The graph the hierarchy was built from, built from a set of nodes
+     * @param result Receives the edges from start to end, cleared if no path was found
+     * @return True if a path was found
+     */
+    bool path(const CompactFringeGraph& graph, std::vector<BaseFringeEdge*>& result) const;
+
+private:
+    void begin();
+
+    // Settle the next node of a direction and relax its edges
+    void step(Direction& self, const Direction& other, bool isForward);
+
+    void relax(Direction& self, node_id_t node, edge_weight_t distance, edge_id_t edge);
+};
+
+#endif //USER_EQUILIBRIUM_CONTRACTIONHIERARCHY_H
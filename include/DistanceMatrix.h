@@ -0,0 +1,163 @@
+#ifndef USER_EQUILIBRIUM_DISTANCEMATRIX_H
+#define USER_EQUILIBRIUM_DISTANCEMATRIX_H
+
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "FringeSearchT.h"
+
+/**
+ * Computes many-to-many distance tables on several threads.
+ *
+ * Every call to compute() starts its worker threads, which together with the
+ * calling thread repeatedly take the next source node and run a single
+ * one-to-many search from it towards all targets. The threads are joined before
+ * compute() returns, but every worker keeps its search context between calls,
+ * so computing further matrices does not reallocate search data.
+ *
+ * @tparam Graph The graph type
+ * @tparam Heuristic The heuristic policy
+ * @tparam Weight The weight policy
+ * @tparam Fringe The fringe implementation
+ * @tparam Context The search context layout, BasicSearchContext or ColumnarSearchContext
+ */
+template <class Graph, class Heuristic = ZeroHeuristic, class Weight = DefaultWeight,
+        template <class> class Fringe = LinkedFringe, template <class, class> class Context = BasicSearchContext>
+class DistanceMatrixT {
+public:
+    typedef typename Graph::node_t node_t;
+    typedef FringeSearchT<Graph, Heuristic, Weight, Fringe, Context> search_t;
+    typedef typename search_t::context_t context_t;
+
+private:
+    const Graph& graph;
+
+    Heuristic heuristic;
+
+    Weight weight;
+
+    // The search context of every worker
+    std::vector<std::unique_ptr<context_t>> contexts;
+
+    // Joins the worker threads when leaving compute(), also when the calling thread throws
+    struct WorkerJoiner {
+        std::vector<std::thread>& workers;
+
+        ~WorkerJoiner() {
+            join();
+        }
+
+        void join() {
+            for (std::thread& worker : workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+        }
+    };
+
+public:
+    /**
+     * Create a distance matrix calculator.
+     *
+     * @param graph The graph to search, must outlive this calculator
+     * @param threadCount The number of threads including the calling one, 0 to use one per hardware thread
+     * @param heuristic The heuristic function
+     * @param weight The weight function
+     */
+    DistanceMatrixT(const Graph& graph, unsigned int threadCount = 0, const Heuristic& heuristic = Heuristic(),
+                    const Weight& weight = Weight())
+            : graph(graph), heuristic(heuristic), weight(weight) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+        }
+        if (threadCount == 0) {
+            threadCount = 1;
+        }
+        for (unsigned int t = 0; t < threadCount; t++) {
+            contexts.emplace_back(new context_t(graph.getNodeCount()));
+        }
+    }
+
+    /**
+     * Get the number of worker threads.
+     *
+     * @return The number of worker threads
+     */
+    unsigned int getThreadCount() const {
+        return static_cast<unsigned int>(contexts.size());
+    }
+
+    /**
+     * Compute the cost from every source to every target.
+     *
+     * The matrix is row-major, with the cost from sources[i] to targets[j]
+     * stored at matrix[i * targets.size() + j]. Unreachable targets get
+     * an infinite cost.
+     *
+     * An exception thrown on a worker thread, for example by the heuristic or
+     * an allocation, stops the other workers and is rethrown here once all
+     * threads have stopped. The matrix is incomplete in that case.
+     *
+     * @param sources The source nodes
+     * @param targets The target nodes
+     * @param matrix The matrix to fill, with room for sources.size() * targets.size() costs
+     */
+    void compute(const std::vector<node_t>& sources, const std::vector<node_t>& targets, edge_weight_t* matrix) {
+        std::atomic<std::size_t> nextSource(0);
+
+        // The exception of every worker, thrown on the calling thread after all workers are joined
+        std::vector<std::exception_ptr> errors(contexts.size());
+
+        std::vector<std::thread> workers;
+        WorkerJoiner joiner = {workers};
+        for (std::size_t t = 1; t < contexts.size() && t < sources.size(); t++) {
+            workers.emplace_back(&DistanceMatrixT::workOnThread, this, std::ref(*contexts[t]), std::cref(sources),
+                                 std::cref(targets), matrix, std::ref(nextSource), std::ref(errors[t]));
+        }
+        // The calling thread works as well
+        work(*contexts[0], sources, targets, matrix, nextSource);
+
+        joiner.join();
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+private:
+    // Run work() on a worker thread, where an uncaught exception would terminate the program
+    void workOnThread(context_t& context, const std::vector<node_t>& sources, const std::vector<node_t>& targets,
+                      edge_weight_t* matrix, std::atomic<std::size_t>& nextSource, std::exception_ptr& error) {
+        try {
+            work(context, sources, targets, matrix, nextSource);
+        } catch (...) {
+            error = std::current_exception();
+            // Let the other threads stop after their current source
+            nextSource = sources.size();
+        }
+    }
+
+    void work(context_t& context, const std::vector<node_t>& sources, const std::vector<node_t>& targets,
+              edge_weight_t* matrix, std::atomic<std::size_t>& nextSource) {
+        search_t search(graph, context, heuristic, weight);
+
+        for (std::size_t s = nextSource++; s < sources.size(); s = nextSource++) {
+            search.reset(sources[s]);
+            search.search(targets);
+
+            edge_weight_t* row = matrix + s * targets.size();
+            for (std::size_t t = 0; t < targets.size(); t++) {
+                row[t] = search.reached(targets[t]) ? search.cost(targets[t])
+                                                    : std::numeric_limits<edge_weight_t>::infinity();
+            }
+        }
+    }
+};
+
+#endif //USER_EQUILIBRIUM_DISTANCEMATRIX_H
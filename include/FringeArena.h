@@ -0,0 +1,154 @@
+#ifndef USER_EQUILIBRIUM_FRINGEARENA_H
+#define USER_EQUILIBRIUM_FRINGEARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A bump allocator for objects that are all freed at once.
+ *
+ * Memory is handed out from large blocks and never returned individually.
+ * Objects created with create() are destroyed, in reverse order of creation,
+ * when the arena is destroyed.
+ */
+class FringeArena {
+
+    struct Destructor {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    // Default size of a block
+    std::size_t blockSize;
+
+    // All allocated blocks
+    std::vector<char*> blocks;
+
+    // The total size of all blocks
+    std::size_t allocatedBytes;
+
+    // The next free byte in the current block
+    char* current;
+
+    // The number of free bytes in the current block
+    std::size_t remaining;
+
+    // Destructors of created objects
+    std::vector<Destructor> destructors;
+
+public:
+    /**
+     * Create an empty arena.
+     *
+     * @param blockSize The size of the blocks memory is allocated in
+     */
+    explicit FringeArena(std::size_t blockSize = 1 << 20);
+
+    FringeArena(const FringeArena& other) = delete;
+
+    FringeArena& operator=(const FringeArena& other) = delete;
+
+    /**
+     * Destroy all created objects and free all memory.
+     */
+    ~FringeArena();
+
+    /**
+     * Allocate memory that lives as long as the arena.
+     *
+     * @param size The number of bytes
+     * @param alignment The alignment, a power of two
+     * @return The memory
+     */
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    /**
+     * Create an object in the arena, destroyed when the arena is destroyed.
+     *
+     * @tparam T The object type
+     * @param args The constructor arguments
+     * @return The object
+     */
+    template <class T, class... Args>
+    T* create(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value) {
+            destructors.push_back({object, &destroy<T>});
+        }
+        return object;
+    }
+
+    /**
+     * Get the number of bytes allocated from the system.
+     *
+     * @return The number of bytes
+     */
+    std::size_t getAllocatedBytes() const {
+        return allocatedBytes;
+    }
+
+private:
+    template <class T>
+    static void destroy(void* object) {
+        static_cast<T*>(object)->~T();
+    }
+};
+
+/**
+ * Standard allocator that allocates from a FringeArena, or from the heap if it has no arena.
+ *
+ * Deallocating arena memory does nothing, it is freed with the arena. Memory a
+ * container gives back, such as the old buffers of a growing vector or the room
+ * of removed elements, is never reclaimed until the arena is destroyed, so
+ * reserve the final size up front where it is known.
+ *
+ * @tparam T The allocated type
+ */
+template <class T>
+class FringeArenaAllocator {
+
+    template <class U>
+    friend class FringeArenaAllocator;
+
+    FringeArena* arena;
+
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    FringeArenaAllocator() : arena(nullptr) {}
+
+    FringeArenaAllocator(FringeArena* arena) : arena(arena) {}
+
+    template <class U>
+    FringeArenaAllocator(const FringeArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        if (arena == nullptr) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t n) {
+        if (arena == nullptr) {
+            ::operator delete(pointer);
+        }
+    }
+
+    template <class U>
+    bool operator==(const FringeArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+    template <class U>
+    bool operator!=(const FringeArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+};
+
+#endif //USER_EQUILIBRIUM_FRINGEARENA_H
@@ -6,6 +6,8 @@
 #include <vector>
 #include <memory>
 
+#include "FringeArena.h"
+
 typedef uint32_t node_id_t;
 typedef uint32_t edge_id_t;
 typedef float edge_weight_t;
@@ -17,37 +19,14 @@ template<class data_t>
 struct FringeSearchHeuristic;
 template<class data_t>
 struct FringeEdgeWeightCalculation;
-class FringeSearch;
-
-struct FringeSearchData {
-    // Current best previous node
-    BaseFringeNode* previous;
-    // Current best cost to get from start to this node
-    edge_weight_t g;
-    // Cached heuristic value
-    edge_weight_t h;
-    // Doubly linked list variables
-    BaseFringeNode* fringeNext;
-    BaseFringeNode* fringePrevious;
-    // ID of the search this data belongs to
-    std::size_t searchID;
-};
 
 class BaseFringeNode {
 
-    friend class FringeSearch;
-
     node_id_t id;
 
     std::vector<BaseFringeEdge*> incoming;
     std::vector<BaseFringeEdge*> outgoing;
 
-    /*
-     * Variables used in Fringe Search
-     */
-    FringeSearchData* fringeSearchData;
-
-
 public:
     BaseFringeNode(node_id_t id);
 
@@ -60,21 +39,27 @@ public:
      *
      * @return A unique ID
      */
-    node_id_t getID();
+    node_id_t getID() {
+        return id;
+    }
 
     /**
      * Get the incoming edges.
      *
      * @return The incoming edges
      */
-    std::vector<BaseFringeEdge*>& getIncoming();
+    std::vector<BaseFringeEdge*>& getIncoming() {
+        return incoming;
+    }
 
     /**
      * Get the outgoing edges
      *
      * @return The outgoing edges
      */
-    std::vector<BaseFringeEdge*>& getOutgoing();
+    std::vector<BaseFringeEdge*>& getOutgoing() {
+        return outgoing;
+    }
 
     /**
      * Find an edge that is outgoing from this node and incoming to other.
@@ -98,6 +83,14 @@ public:
      */
     void addOutgoing(BaseFringeEdge* edge);
 
+    /**
+     * Make room for more edges, so adding them does not reallocate the adjacency lists.
+     *
+     * @param incomingCount The number of incoming edges to make room for
+     * @param outgoingCount The number of outgoing edges to make room for
+     */
+    void reserveEdges(std::size_t incomingCount, std::size_t outgoingCount);
+
     /**
      * Calculate the heuristic value h from this node to to, used by fringe search.
      *
@@ -199,14 +192,18 @@ public:
      *
      * @return The ID
      */
-    edge_id_t getID();
+    edge_id_t getID() {
+        return id;
+    }
 
     /**
      * Get the source node.
      *
      * @return The source node
      */
-    BaseFringeNode* getFrom();
+    BaseFringeNode* getFrom() {
+        return from;
+    }
 
     /**
      * Set the source node.
@@ -222,7 +219,9 @@ public:
      *
      * @return The target node
      */
-    BaseFringeNode* getTo();
+    BaseFringeNode* getTo() {
+        return to;
+    }
 
     /**
      * Set the target node.
@@ -238,7 +237,9 @@ public:
      *
      * @return The weight
      */
-    edge_weight_t getWeight();
+    edge_weight_t getWeight() {
+        return weight;
+    }
 
     /**
      * Set the default weight of this edge.
@@ -324,9 +325,142 @@ struct FringeEdgeWeightCalculation {
     static edge_weight_t weight(FringeEdge<data_t>* edge, edge_weight_t costToFrom);
 };
 
+// Default heuristic implementation, always underestimates so is admissible
+template <>
+inline edge_weight_t FringeSearchHeuristic<void>::h(FringeNode<void>* /*from*/, FringeNode<void>* /*to*/) {
+    return 0;
+}
+
+// Default edge weight calculation implementation, always returns the default weight
+template <>
+inline edge_weight_t FringeEdgeWeightCalculation<void>::weight(FringeEdge<void>* edge, edge_weight_t /*costToFrom*/) {
+    return edge->getWeight();
+}
+
 typedef FringeEdge<void> fringe_edge_t;
 typedef FringeNode<void> fringe_node_t;
 
+/**
+ * A graph owning its nodes and edges.
+ *
+ * Nodes and edges are allocated from a single arena instead of one heap
+ * allocation each, and are all destroyed at once with the graph. Nodes and
+ * edges can not be removed. The adjacency lists of the nodes stay ordinary
+ * vectors, so every node can be used the same way; reserve them with
+ * BaseFringeNode::reserveEdges() before adding edges, as GraphBuilder::build()
+ * does, so every list is allocated once. The graph can be searched through
+ * PointerFringeGraph or FringeSearch like nodes created with new.
+ */
+class FringeGraph {
+
+    FringeArena arena;
+
+    std::vector<BaseFringeNode*> nodes;
+
+    // Maps node IDs to nodes, nullptr for IDs without a node
+    std::vector<BaseFringeNode*> nodesById;
+
+    // The ID of the next edge
+    edge_id_t edgeCount;
+
+public:
+    /**
+     * Create an empty graph.
+     *
+     * @param blockSize The size of the blocks the arena allocates memory in
+     */
+    explicit FringeGraph(std::size_t blockSize = 1 << 20);
+
+    FringeGraph(const FringeGraph& other) = delete;
+
+    FringeGraph& operator=(const FringeGraph& other) = delete;
 
+    /**
+     * Add a node.
+     *
+     * @tparam node_type The node type, derived from BaseFringeNode
+     * @param id The unique ID of the node
+     * @param args Further constructor arguments after the ID
+     * @return The node, owned by this graph
+     */
+    template <class node_type = fringe_node_t, class... Args>
+    node_type* addNode(node_id_t id, Args&&... args) {
+        node_type* node = arena.create<node_type>(id, std::forward<Args>(args)...);
+        nodes.push_back(node);
+        if (id >= nodesById.size()) {
+            nodesById.resize(static_cast<std::size_t>(id) + 1, nullptr);
+        }
+        nodesById[id] = node;
+        return node;
+    }
+
+    /**
+     * Add an edge between two nodes of this graph, edges are numbered in order of addition.
+     *
+     * @tparam edge_type The edge type, derived from BaseFringeEdge
+     * @param from The source node
+     * @param to The target node
+     * @param weight The default weight
+     * @param args Further constructor arguments after the weight
+     * @return The edge, owned by this graph
+     */
+    template <class edge_type = fringe_edge_t, class... Args>
+    edge_type* addEdge(BaseFringeNode* from, BaseFringeNode* to, edge_weight_t weight, Args&&... args) {
+        return arena.create<edge_type>(edgeCount++, from, to, weight, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Make room for nodes with IDs in [0, nodeCount).
+     *
+     * @param nodeCount The number of nodes to make room for
+     */
+    void reserveNodes(node_id_t nodeCount);
+
+    /**
+     * Get a node by its ID.
+     *
+     * @param id The node ID
+     * @return The node, or nullptr if this graph has no node with this ID
+     */
+    BaseFringeNode* getNode(node_id_t id) const {
+        return id < nodesById.size() ? nodesById[id] : nullptr;
+    }
+
+    /**
+     * Get all nodes in order of addition.
+     *
+     * @return The nodes
+     */
+    const std::vector<BaseFringeNode*>& getNodes() const {
+        return nodes;
+    }
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return The number of nodes
+     */
+    std::size_t getNodeCount() const {
+        return nodes.size();
+    }
+
+    /**
+     * Get the number of edges.
+     *
+     * @return The number of edges
+     */
+    std::size_t getEdgeCount() const {
+        return edgeCount;
+    }
+
+    /**
+     * Get the memory used by this graph's nodes, edges and adjacency lists.
+     *
+     * @return The number of bytes
+     */
+    std::size_t getAllocatedBytes() const {
+        return arena.getAllocatedBytes();
+    }
+};
 
 #endif //USER_EQUILIBRIUM_FRINGEGRAPH_H
@@ -0,0 +1,227 @@
+#ifndef USER_EQUILIBRIUM_FRINGELISTS_H
+#define USER_EQUILIBRIUM_FRINGELISTS_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "SearchContext.h"
+
+/*
+ * Fringe implementations for FringeSearchT.
+ *
+ * A fringe is scanned once per threshold iteration. first() starts a scan and
+ * returns the first node to visit. The visited node is then either deferred to
+ * the next iteration with defer() or expanded with expand(), both return the
+ * next node to visit in this iteration. Children added with add() while expanding
+ * are visited later in the same iteration. endIteration() prepares the next scan.
+ * contains() tells whether a node is currently in the fringe.
+ *
+ * The data argument maps a node to its search data, of type Data::reference, which
+ * is either a FringeSearchData reference or a FringeSearchDataReference.
+ */
+
+/**
+ * Fringe kept as a single intrusive doubly linked list through the search data
+ * of its nodes. Deferred nodes stay in the list and are rescanned every iteration.
+ *
+ * @tparam node_t The node reference type
+ */
+template <class node_t>
+class LinkedFringe {
+
+    // The first node of the fringe
+    node_t fringeStart;
+
+    // The last node of the fringe
+    node_t fringeEnd;
+
+public:
+    template <class Data>
+    void reset(Data& /*data*/, node_t start) {
+        fringeStart = start;
+        fringeEnd = start;
+    }
+
+    bool empty() const {
+        return fringeStart == SearchNodeTraits<node_t>::none();
+    }
+
+    template <class Data>
+    bool contains(Data& data, node_t node) const {
+        // Only the first node of the list has no previous node
+        return node == fringeStart || data(node).fringePrevious != SearchNodeTraits<node_t>::none();
+    }
+
+    template <class Data>
+    node_t first(Data& /*data*/) {
+        return fringeStart;
+    }
+
+    template <class Data>
+    node_t defer(Data& data, node_t current) {
+        // Do not remove current, so it will implicitly be considered later
+        return data(current).fringeNext;
+    }
+
+    template <class Data>
+    void add(Data& data, node_t child) {
+        const node_t none = SearchNodeTraits<node_t>::none();
+
+        // Add the child for immediate consideration, causing it to be removed from elsewhere in the fringe
+        remove(data, child);
+        if (fringeEnd != none) {
+            data(fringeEnd).fringeNext = child;
+        }
+        typename Data::reference childData = data(child);
+        childData.fringePrevious = fringeEnd;
+        childData.fringeNext = none;
+        fringeEnd = child;
+    }
+
+    template <class Data>
+    node_t expand(Data& data, node_t current) {
+        const node_t none = SearchNodeTraits<node_t>::none();
+        node_t next = data(current).fringeNext;
+
+        // Erase current
+        remove(data, current);
+        typename Data::reference currentData = data(current);
+        currentData.fringeNext = none;
+        currentData.fringePrevious = none;
+        return next;
+    }
+
+    template <class Data>
+    void endIteration(Data& /*data*/) {}
+
+private:
+    template <class Data>
+    void remove(Data& data, node_t node) {
+        const node_t none = SearchNodeTraits<node_t>::none();
+        typename Data::reference nodeData = data(node);
+
+        if (node == fringeStart) {
+            fringeStart = nodeData.fringeNext;
+        } else if (nodeData.fringePrevious != none) {
+            data(nodeData.fringePrevious).fringeNext = nodeData.fringeNext;
+        }
+
+        if (node == fringeEnd) {
+            fringeEnd = nodeData.fringePrevious;
+        } else if (nodeData.fringeNext != none) {
+            data(nodeData.fringeNext).fringePrevious = nodeData.fringePrevious;
+        }
+    }
+};
+
+/**
+ * Fringe kept as two contiguous lists, as in the original Fringe Search paper.
+ *
+ * Nodes to visit in the current iteration are in the now list, deferred nodes are
+ * appended to the later list, and the lists are swapped at the end of an iteration.
+ * Instead of unlinking nodes, every node has a state byte telling which list it
+ * currently belongs to, and list entries that do not match their node's state
+ * are skipped. The state also tells whether the later list has an entry for the
+ * node, so a node is listed there at most once. Scans are sequential and the
+ * lists are reused between searches.
+ *
+ * @tparam node_t The node reference type
+ */
+template <class node_t>
+class SplitFringe {
+
+    std::vector<node_t> now;
+
+    std::vector<node_t> later;
+
+    // The position of the next node in now to visit
+    std::size_t cursor;
+
+public:
+    template <class Data>
+    void reset(Data& data, node_t start) {
+        now.clear();
+        later.clear();
+        now.push_back(start);
+        data(start).fringeState = FRINGE_NOW;
+        cursor = 0;
+    }
+
+    bool empty() const {
+        return cursor >= now.size() && later.empty();
+    }
+
+    template <class Data>
+    bool contains(Data& data, node_t node) const {
+        return (data(node).fringeState & ~FRINGE_LISTED_LATER) != FRINGE_NONE;
+    }
+
+    template <class Data>
+    node_t first(Data& data) {
+        cursor = 0;
+        return next(data);
+    }
+
+    template <class Data>
+    node_t defer(Data& data, node_t current) {
+        // A node that was deferred, then added again in this iteration, already has an entry in later
+        typename Data::reference currentData = data(current);
+        if (!(currentData.fringeState & FRINGE_LISTED_LATER)) {
+            later.push_back(current);
+        }
+        currentData.fringeState = FRINGE_LATER | FRINGE_LISTED_LATER;
+        return next(data);
+    }
+
+    template <class Data>
+    void add(Data& data, node_t child) {
+        // Children already in now are still ahead of the cursor, the others are appended
+        typename Data::reference childData = data(child);
+        if ((childData.fringeState & ~FRINGE_LISTED_LATER) != FRINGE_NOW) {
+            childData.fringeState = FRINGE_NOW | (childData.fringeState & FRINGE_LISTED_LATER);
+            now.push_back(child);
+        }
+    }
+
+    template <class Data>
+    node_t expand(Data& data, node_t current) {
+        typename Data::reference currentData = data(current);
+        currentData.fringeState = FRINGE_NONE | (currentData.fringeState & FRINGE_LISTED_LATER);
+        return next(data);
+    }
+
+    template <class Data>
+    void endIteration(Data& data) {
+        std::swap(now, later);
+        later.clear();
+
+        // Every node is listed once, drop the entries of nodes that were added again and expanded since
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < now.size(); i++) {
+            typename Data::reference nodeData = data(now[i]);
+            if (nodeData.fringeState == (FRINGE_LATER | FRINGE_LISTED_LATER)) {
+                nodeData.fringeState = FRINGE_NOW;
+                now[size++] = now[i];
+            } else {
+                nodeData.fringeState &= ~FRINGE_LISTED_LATER;
+            }
+        }
+        now.resize(size);
+        cursor = 0;
+    }
+
+private:
+    template <class Data>
+    node_t next(Data& data) {
+        while (cursor < now.size()) {
+            node_t node = now[cursor++];
+            if ((data(node).fringeState & ~FRINGE_LISTED_LATER) == FRINGE_NOW) {
+                return node;
+            }
+        }
+        return SearchNodeTraits<node_t>::none();
+    }
+};
+
+#endif //USER_EQUILIBRIUM_FRINGELISTS_H
@@ -6,30 +6,40 @@
 #include <vector>
 #include <unordered_map>
 #include <utility>
+#include <memory>
 
 #include "FringeGraph.h"
+#include "FringeSearchT.h"
+#include "PointerFringeGraph.h"
+#include "SearchContext.h"
 
 typedef std::pair<BaseFringeNode*, edge_weight_t> node_parent_t;
 
 /**
  * Implementation of the fringe search algorithm.
+ *
+ * Search data is stored in a SearchContext indexed by node ID. Use one context
+ * per thread to search the same graph from multiple threads at once.
+ *
+ * Heuristics and weights are computed through BaseFringeNode::calculateHeuristic
+ * and BaseFringeEdge::calculateWeight. To have them inlined instead, use
+ * FringeSearchT with PointerFringeGraph and DataHeuristic/DataWeight directly.
+ *
+ * Search statistics are only counted if the library is built with the
+ * FRINGE_SEARCH_STATISTICS option.
  */
 class FringeSearch {
 
-    // searchID counter
-    static std::size_t nextSearchID;
+    PointerFringeGraph graph;
 
-    // The ID of this search, used to see if search data was created by this search
-    std::size_t searchID;
+#ifdef FRINGE_SEARCH_STATISTICS
+    static const bool COUNT_STATISTICS = true;
+#else
+    static const bool COUNT_STATISTICS = false;
+#endif
 
-    // The first node of the fringe
-    BaseFringeNode* fringeStart;
-
-    // The last node of the fringe
-    BaseFringeNode* fringeEnd;
-
-    // The search' starting node
-    BaseFringeNode* start;
+    FringeSearchT<PointerFringeGraph, WeightedHeuristic<VirtualHeuristic>, VirtualWeight, LinkedFringe,
+            BasicSearchContext, COUNT_STATISTICS> engine;
 
 public:
     /**
@@ -46,6 +56,23 @@ public:
      */
     FringeSearch(BaseFringeNode* start);
 
+    /**
+     * Create a fringe search instance using the given context, but do not initialize.
+     *
+     * Call reset() before calling search().
+     *
+     * @param context The context to store search data in, must outlive this search
+     */
+    FringeSearch(SearchContext& context);
+
+    /**
+     * Initialize the search given a context and a source node.
+     *
+     * @param context The context to store search data in, must outlive this search
+     * @param start The source node
+     */
+    FringeSearch(SearchContext& context, BaseFringeNode* start);
+
     /**
      * Search for a target node.
      *
@@ -54,13 +81,60 @@ public:
      */
     std::vector<BaseFringeNode*>* search(BaseFringeNode* end);
 
+    /**
+     * Search for a target node and store the path in a reusable buffer.
+     *
+     * @param end The target node
+     * @param path The buffer to store the path from start to end in, cleared if no path was found
+     * @return True if a path was found
+     */
+    bool search(BaseFringeNode* end, PathBuffer<PointerFringeGraph>& path);
+
+    /**
+     * Search for a target node and store the path in a caller-supplied buffer.
+     *
+     * @param end The target node
+     * @param buffer The buffer to store the nodes from start to end in
+     * @param capacity The number of nodes that fit in buffer
+     * @return The number of nodes on the path, 0 if no path was found. If this is
+     *         larger than capacity, nothing is written.
+     */
+    std::size_t search(BaseFringeNode* end, BaseFringeNode** buffer, std::size_t capacity);
+
+    /**
+     * Search for the cost to a target node without reconstructing the path.
+     *
+     * @param end The target node
+     * @return The cost of the path, or infinity if no path was found
+     */
+    edge_weight_t searchCost(BaseFringeNode* end);
+
+    /**
+     * Search for multiple target nodes with a single expansion.
+     *
+     * Afterwards, use path() and cost() to get the results per target. Other
+     * nodes discovered on the way may not have their final cost and are not reported.
+     *
+     * @param targets The target nodes
+     * @return The number of distinct targets that were reached
+     */
+    std::size_t search(const std::vector<BaseFringeNode*>& targets);
+
+    /**
+     * Get the path to a target reached by the last search.
+     *
+     * @param end The target node
+     * @return The nodes to visit excluding start, including end, or nullptr if end was not reached
+     */
+    std::vector<BaseFringeNode*>* path(BaseFringeNode* end);
+
     /**
      * Get the cost to the given target node.
      *
      * Call search() before calling this.
      *
      * @param end The target node
-     * @return cost The cost of the path
+     * @return cost The cost of the path, or infinity if end is not a target the last search reached
      */
     edge_weight_t cost(BaseFringeNode* end);
 
@@ -71,12 +145,19 @@ public:
      */
     void reset(BaseFringeNode* start);
 
-private:
-    void removeFromFringe(const BaseFringeNode *node);
-
-    void allocateSearchData(BaseFringeNode* node);
+    /**
+     * Inflate the heuristic of the next searches, trading path cost for search time.
+     *
+     * @param weight The factor w in f = g + w * h, paths cost at most w times the optimal cost. 1 by default.
+     */
+    void setHeuristicWeight(edge_weight_t weight);
 
-    void setStartingNode(BaseFringeNode* start);
+    /**
+     * Get the work done by the last search.
+     *
+     * @return The statistics of the last search, all 0 unless built with FRINGE_SEARCH_STATISTICS
+     */
+    const SearchStatistics& getStatistics() const;
 };
 
 #endif //USER_EQUILIBRIUM_FRINGESEARCH_H
@@ -0,0 +1,127 @@
+#ifndef USER_EQUILIBRIUM_FRINGESEARCHPOLICIES_H
+#define USER_EQUILIBRIUM_FRINGESEARCHPOLICIES_H
+
+#include "FringeGraph.h"
+
+/*
+ * Heuristic and weight policies for FringeSearchT.
+ *
+ * A heuristic policy is called as heuristic(graph, from, to) and returns an
+ * estimate of the cost from from to to. A weight policy is called as
+ * weight(graph, edge, costToFrom) and returns the cost of traversing edge.
+ * Policies are passed by type, so their calls are inlined into the search loop.
+ */
+
+/**
+ * Generates the successors FringeSearchT expands a node to, by default all outgoing edges.
+ *
+ * Specialize this for graphs that prune successors based on the edge a node was
+ * reached by, see JumpPointGraph. The start node was reached by the edge
+ * SearchNodeTraits<edge_t>::none().
+ *
+ * @tparam Graph The graph type
+ */
+template <class Graph>
+struct SuccessorTraits {
+    static typename Graph::edge_iterator getFirst(const Graph& graph, typename Graph::node_t node,
+                                                  const typename Graph::edge_t& /*previous*/) {
+        return graph.getFirstOutgoing(node);
+    }
+
+    static typename Graph::edge_iterator getLast(const Graph& graph, typename Graph::node_t node,
+                                                 const typename Graph::edge_t& /*previous*/) {
+        return graph.getLastOutgoing(node);
+    }
+};
+
+/**
+ * Heuristic that is always 0, turning fringe search into an iterative deepening Dijkstra.
+ */
+struct ZeroHeuristic {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::node_t from, typename Graph::node_t to) const {
+        return 0;
+    }
+};
+
+/**
+ * Heuristic that calls BaseFringeNode::calculateHeuristic, for graphs mixing node types.
+ */
+struct VirtualHeuristic {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& /*graph*/, BaseFringeNode* from, BaseFringeNode* to) const {
+        return from->calculateHeuristic(to);
+    }
+};
+
+/**
+ * Heuristic that calls FringeSearchHeuristic<data_t> directly, for graphs of FringeNode<data_t>.
+ *
+ * @tparam data_t The type of data stored in the nodes
+ */
+template <class data_t>
+struct DataHeuristic {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, BaseFringeNode* from, BaseFringeNode* to) const {
+        return FringeSearchHeuristic<data_t>::h(static_cast<FringeNode<data_t>*>(from),
+                                                static_cast<FringeNode<data_t>*>(to));
+    }
+};
+
+/**
+ * Heuristic that inflates another heuristic by a constant factor, so f = g + w * h.
+ *
+ * With an admissible heuristic and a factor w >= 1, fringe search returns a path
+ * costing at most w times the optimal cost, after fewer threshold iterations.
+ *
+ * @tparam Heuristic The inflated heuristic policy
+ */
+template <class Heuristic>
+struct WeightedHeuristic {
+    Heuristic heuristic;
+
+    edge_weight_t factor;
+
+    WeightedHeuristic(edge_weight_t factor = 1, const Heuristic& heuristic = Heuristic())
+            : heuristic(heuristic), factor(factor) {}
+
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::node_t from, typename Graph::node_t to) const {
+        return factor * heuristic(graph, from, to);
+    }
+};
+
+/**
+ * Weight that is the default weight of the edge, as stored in the graph.
+ */
+struct DefaultWeight {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::edge_t edge, edge_weight_t /*costToFrom*/) const {
+        return graph.getWeight(edge);
+    }
+};
+
+/**
+ * Weight that calls BaseFringeEdge::calculateWeight, for graphs mixing edge types.
+ */
+struct VirtualWeight {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& /*graph*/, BaseFringeEdge* edge, edge_weight_t costToFrom) const {
+        return edge->calculateWeight(costToFrom);
+    }
+};
+
+/**
+ * Weight that calls FringeEdgeWeightCalculation<data_t> directly, for graphs of FringeEdge<data_t>.
+ *
+ * @tparam data_t The type of data stored in the edges
+ */
+template <class data_t>
+struct DataWeight {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, BaseFringeEdge* edge, edge_weight_t costToFrom) const {
+        return FringeEdgeWeightCalculation<data_t>::weight(static_cast<FringeEdge<data_t>*>(edge), costToFrom);
+    }
+};
+
+#endif //USER_EQUILIBRIUM_FRINGESEARCHPOLICIES_H
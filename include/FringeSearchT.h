@@ -0,0 +1,594 @@
+#ifndef USER_EQUILIBRIUM_FRINGESEARCHT_H
+#define USER_EQUILIBRIUM_FRINGESEARCHT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "FringeGraph.h"
+#include "FringeLists.h"
+#include "FringeSearchPolicies.h"
+#include "SearchContext.h"
+
+/**
+ * Reusable storage for a path found by a search.
+ *
+ * Reusing one buffer for many searches only allocates when a path is longer
+ * than any path stored in it before.
+ *
+ * @tparam Graph The graph type
+ */
+template <class Graph>
+struct PathBuffer {
+    // The nodes on the path in order, including start and end
+    std::vector<typename Graph::node_t> nodes;
+
+    // The edges on the path in order, the edge at position i connects nodes i and i + 1
+    std::vector<typename Graph::edge_t> edges;
+};
+
+/**
+ * Counters describing the work done by a single search.
+ */
+struct SearchStatistics {
+    // The number of threshold iterations, including the last one
+    uint64_t iterations;
+
+    // The number of times a node in the fringe was visited, whether it was expanded or deferred
+    uint64_t scanned;
+
+    // The number of node expansions
+    uint64_t expanded;
+
+    // The number of times a node was deferred to the next iteration, each one is scanned again later
+    uint64_t deferred;
+
+    // The number of edges followed from expanded nodes
+    uint64_t relaxations;
+
+    // The number of times a node that already left the fringe was added again, after a cheaper route to it was found
+    uint64_t reopened;
+
+    // The number of heuristic estimates computed
+    uint64_t heuristicCalls;
+
+    // The number of heuristic estimates taken from the search data instead
+    uint64_t heuristicCacheHits;
+
+    // The largest number of nodes in the fringe at once
+    uint64_t peakFringeSize;
+};
+
+/**
+ * Implementation of the fringe search algorithm on any graph type.
+ *
+ * The graph type provides node_t, edge_t and edge_iterator types, and the
+ * members getNodeCount(), getIndex(node), getFirstOutgoing(node),
+ * getLastOutgoing(node), getEdge(iterator), getSource(edge), getTarget(edge)
+ * and getWeight(edge), see PointerFringeGraph and CompactFringeGraph. Nodes
+ * are expanded to the edges given by SuccessorTraits, all outgoing edges
+ * unless the graph specializes it.
+ *
+ * The search keeps the edge every node was reached by, so paths can be
+ * returned as edges as well, even with parallel edges.
+ *
+ * The heuristic and weight functions are policies, see FringeSearchPolicies.h.
+ * The fringe is either a LinkedFringe or a SplitFringe, see FringeLists.h.
+ * Search data is stored in a context, use one context per thread to search the
+ * same graph from multiple threads at once.
+ *
+ * Every call to search() starts over from the starting node, so one instance
+ * can be reused for any number of targets. To reach several targets with a
+ * single expansion, search for all of them at once.
+ *
+ * With Statistics enabled, every search counts its work in a SearchStatistics,
+ * otherwise the counting code is not compiled in.
+ *
+ * @tparam Graph The graph type
+ * @tparam Heuristic The heuristic policy
+ * @tparam Weight The weight policy
+ * @tparam Fringe The fringe implementation
+ * @tparam Context The search context layout, BasicSearchContext or ColumnarSearchContext
+ * @tparam Statistics Whether to count search statistics
+ */
+template <class Graph, class Heuristic = ZeroHeuristic, class Weight = DefaultWeight,
+        template <class> class Fringe = LinkedFringe, template <class, class> class Context = BasicSearchContext,
+        bool Statistics = false>
+class FringeSearchT {
+public:
+    typedef typename Graph::node_t node_t;
+    typedef typename Graph::edge_t edge_t;
+    typedef typename Graph::edge_iterator edge_iterator;
+    typedef Context<node_t, edge_t> context_t;
+
+private:
+    // Maps nodes to their search data for the fringe
+    struct DataAccess {
+        typedef typename context_t::reference reference;
+
+        const Graph& graph;
+        context_t& context;
+
+        reference operator()(node_t node) const {
+            return context[graph.getIndex(node)];
+        }
+    };
+
+    // A single target, the search stops as soon as it is reached
+    struct SingleTarget {
+        node_t end;
+
+        // Whether the target was reached, the only entry of the target bookkeeping
+        std::vector<bool>& reached;
+
+        std::size_t size() const {
+            return 1;
+        }
+
+        bool reach(const Graph& /*graph*/, node_t node) {
+            if (node != end) {
+                return false;
+            }
+            reached[0] = true;
+            return true;
+        }
+
+        edge_weight_t estimate(const Graph& graph, const Heuristic& heuristic, node_t node) const {
+            return heuristic(graph, node, end);
+        }
+    };
+
+    // Multiple targets, estimated by the minimum heuristic over all targets so the estimate stays admissible
+    struct MultipleTargets {
+        const std::vector<node_t>& targets;
+
+        // The sorted indices of the targets
+        std::vector<node_id_t>& indices;
+
+        // Whether the target at the same position in indices was reached
+        std::vector<bool>& reached;
+
+        std::size_t size() const {
+            return indices.size();
+        }
+
+        bool reach(const Graph& graph, node_t node) {
+            node_id_t index = graph.getIndex(node);
+            typename std::vector<node_id_t>::iterator it = std::lower_bound(indices.begin(), indices.end(), index);
+            if (it == indices.end() || *it != index || reached[it - indices.begin()]) {
+                return false;
+            }
+            reached[it - indices.begin()] = true;
+            return true;
+        }
+
+        edge_weight_t estimate(const Graph& graph, const Heuristic& heuristic, node_t node) const {
+            edge_weight_t h = std::numeric_limits<edge_weight_t>::max();
+            for (node_t target : targets) {
+                h = std::min(h, heuristic(graph, node, target));
+            }
+            return h;
+        }
+    };
+
+    const Graph& graph;
+
+    Heuristic heuristic;
+
+    Weight weight;
+
+    // The context owned by this search if none was given
+    std::unique_ptr<context_t> ownedContext;
+
+    // The search data of this search
+    context_t* context;
+
+    Fringe<node_t> fringe;
+
+    // The search' starting node
+    node_t start;
+
+    // The sorted indices of the targets of the last search and whether each was reached, reused between searches
+    std::vector<node_id_t> targetIndices;
+    std::vector<bool> targetReached;
+
+    // The work done by the last search, if counted
+    SearchStatistics statistics;
+
+public:
+    /**
+     * Create a fringe search instance, but do not initialize.
+     *
+     * Call reset() before calling search().
+     *
+     * @param graph The graph to search, must outlive this search
+     * @param heuristic The heuristic function
+     * @param weight The weight function
+     */
+    FringeSearchT(const Graph& graph, const Heuristic& heuristic = Heuristic(), const Weight& weight = Weight())
+            : graph(graph), heuristic(heuristic), weight(weight),
+              ownedContext(new context_t(graph.getNodeCount())), context(ownedContext.get()), statistics() {}
+
+    /**
+     * Create a fringe search instance using the given context, but do not initialize.
+     *
+     * Call reset() before calling search().
+     *
+     * @param graph The graph to search, must outlive this search
+     * @param context The context to store search data in, must outlive this search
+     * @param heuristic The heuristic function
+     * @param weight The weight function
+     */
+    FringeSearchT(const Graph& graph, context_t& context, const Heuristic& heuristic = Heuristic(),
+                  const Weight& weight = Weight())
+            : graph(graph), heuristic(heuristic), weight(weight), context(&context), statistics() {
+        context.reserve(graph.getNodeCount());
+    }
+
+    /**
+     * Search for a target node.
+     *
+     * @param end The target node.
+     * @return The nodes to visit excluding start, including end, in reverse order
+     */
+    std::vector<node_t>* search(node_t end) {
+        SingleTarget target = singleTarget(end);
+        if (run(target) == 0) {
+            return nullptr;
+        }
+        return path(end);
+    }
+
+    /**
+     * Search for a target node and store the path in a reusable buffer.
+     *
+     * @param end The target node
+     * @param path The buffer to store the path from start to end in, cleared if no path was found
+     * @return True if a path was found
+     */
+    bool search(node_t end, PathBuffer<Graph>& path) {
+        SingleTarget target = singleTarget(end);
+        if (run(target) == 0) {
+            path.nodes.clear();
+            path.edges.clear();
+            return false;
+        }
+        writePath(end, path);
+        return true;
+    }
+
+    /**
+     * Search for a target node and store the path in a caller-supplied buffer.
+     *
+     * @param end The target node
+     * @param buffer The buffer to store the nodes from start to end in
+     * @param capacity The number of nodes that fit in buffer
+     * @return The number of nodes on the path, 0 if no path was found. If this is
+     *         larger than capacity, nothing is written and the search can be
+     *         repeated with a larger buffer.
+     */
+    std::size_t search(node_t end, node_t* buffer, std::size_t capacity) {
+        SingleTarget target = singleTarget(end);
+        if (run(target) == 0) {
+            return 0;
+        }
+        std::size_t length = pathLength(end);
+        if (length <= capacity) {
+            writePath(end, buffer, length);
+        }
+        return length;
+    }
+
+    /**
+     * Search for the cost to a target node without reconstructing the path.
+     *
+     * @param end The target node
+     * @return The cost of the path, or infinity if no path was found
+     */
+    edge_weight_t searchCost(node_t end) {
+        SingleTarget target = singleTarget(end);
+        if (run(target) == 0) {
+            return std::numeric_limits<edge_weight_t>::infinity();
+        }
+        return cost(end);
+    }
+
+    /**
+     * Search for multiple target nodes with a single expansion.
+     *
+     * Afterwards, use path() and cost() to get the results per target. The
+     * search stops once all targets are reached, so other nodes it discovered
+     * on the way may not have their final cost and are not reported.
+     *
+     * @param targets The target nodes
+     * @return The number of distinct targets that were reached
+     */
+    std::size_t search(const std::vector<node_t>& targets) {
+        targetIndices.clear();
+        for (node_t target : targets) {
+            targetIndices.push_back(graph.getIndex(target));
+        }
+        std::sort(targetIndices.begin(), targetIndices.end());
+        targetIndices.erase(std::unique(targetIndices.begin(), targetIndices.end()), targetIndices.end());
+        targetReached.assign(targetIndices.size(), false);
+
+        MultipleTargets multipleTargets = {targets, targetIndices, targetReached};
+        return run(multipleTargets);
+    }
+
+    /**
+     * Get the path to a target reached by the last search.
+     *
+     * @param end The target node
+     * @return The nodes to visit excluding start, including end, in reverse order, or nullptr if end was not reached
+     */
+    std::vector<node_t>* path(node_t end) const {
+        if (!reached(end)) {
+            return nullptr;
+        }
+
+        std::vector<node_t>* result = new std::vector<node_t>();
+
+        node_t current = end;
+        while (current != start) {
+            result->push_back(current);
+            current = previous(current);
+        }
+        return result;
+    }
+
+    /**
+     * Get the path to a target reached by the last search and store it in a reusable buffer.
+     *
+     * @param end The target node
+     * @param path The buffer to store the path from start to end in, cleared if end was not reached
+     * @return True if end was reached
+     */
+    bool path(node_t end, PathBuffer<Graph>& path) const {
+        if (!reached(end)) {
+            path.nodes.clear();
+            path.edges.clear();
+            return false;
+        }
+        writePath(end, path);
+        return true;
+    }
+
+    /**
+     * Check if a target of the last search was reached.
+     *
+     * Nodes that were only discovered on the way to the targets are not
+     * reached, as the search may have stopped before finding their best path.
+     *
+     * @param end The target node
+     * @return True if end was a target of the last search and an optimal path to it was found
+     */
+    bool reached(node_t end) const {
+        node_id_t index = graph.getIndex(end);
+        typename std::vector<node_id_t>::const_iterator it =
+                std::lower_bound(targetIndices.begin(), targetIndices.end(), index);
+        return it != targetIndices.end() && *it == index && targetReached[it - targetIndices.begin()];
+    }
+
+    /**
+     * Get the cost to the given target node.
+     *
+     * Call search() before calling this.
+     *
+     * @param end The target node
+     * @return cost The cost of the path, or infinity if end is not a target the last search reached
+     */
+    edge_weight_t cost(node_t end) const {
+        if (!reached(end)) {
+            return std::numeric_limits<edge_weight_t>::infinity();
+        }
+        return (*context)[graph.getIndex(end)].g;
+    }
+
+    /**
+     * Reset the search so a search with a different starting node can start
+     *
+     * @param start The new starting node
+     */
+    void reset(node_t start) {
+        this->start = start;
+    }
+
+    /**
+     * Replace the heuristic function used by the next searches.
+     *
+     * @param heuristic The heuristic function
+     */
+    void setHeuristic(const Heuristic& heuristic) {
+        this->heuristic = heuristic;
+    }
+
+    /**
+     * Get the work done by the last search.
+     *
+     * @return The statistics of the last search, all 0 unless Statistics is enabled
+     */
+    const SearchStatistics& getStatistics() const {
+        return statistics;
+    }
+
+private:
+    // Make end the only target in the target bookkeeping
+    SingleTarget singleTarget(node_t end) {
+        targetIndices.assign(1, graph.getIndex(end));
+        targetReached.assign(1, false);
+        return {end, targetReached};
+    }
+
+    template <class Targets>
+    std::size_t run(Targets& targets);
+
+    std::size_t pathLength(node_t end) const {
+        std::size_t length = 1;
+        for (node_t current = end; current != start; current = previous(current)) {
+            length++;
+        }
+        return length;
+    }
+
+    node_t previous(node_t node) const {
+        return graph.getSource((*context)[graph.getIndex(node)].previousEdge);
+    }
+
+    // Write the path of the given length backwards, so it ends up in order without reversing
+    void writePath(node_t end, node_t* buffer, std::size_t length) const {
+        node_t current = end;
+        for (std::size_t i = length; i > 0; i--) {
+            buffer[i - 1] = current;
+            if (i > 1) {
+                current = previous(current);
+            }
+        }
+    }
+
+    void writePath(node_t end, PathBuffer<Graph>& path) const {
+        std::size_t length = pathLength(end);
+        path.nodes.resize(length);
+        path.edges.resize(length - 1);
+
+        node_t current = end;
+        for (std::size_t i = length - 1; i > 0; i--) {
+            path.nodes[i] = current;
+            edge_t edge = (*context)[graph.getIndex(current)].previousEdge;
+            path.edges[i - 1] = edge;
+            current = graph.getSource(edge);
+        }
+        path.nodes[0] = current;
+    }
+};
+
+template <class Graph, class Heuristic, class Weight, template <class> class Fringe,
+        template <class, class> class Context, bool Statistics>
+template <class Targets>
+std::size_t FringeSearchT<Graph, Heuristic, Weight, Fringe, Context, Statistics>::run(Targets& targets) {
+    const node_t none = SearchNodeTraits<node_t>::none();
+    DataAccess data = {graph, *context};
+
+    context->begin();
+    context->initialize(graph.getIndex(start));
+    fringe.reset(data, start);
+
+    std::size_t remaining = targets.size();
+    edge_weight_t limit = targets.estimate(graph, heuristic, start);
+
+    // The number of nodes in the fringe, only counted for the statistics
+    uint64_t fringeSize = 1;
+    if (Statistics) {
+        statistics = SearchStatistics();
+        statistics.heuristicCalls = 1;
+        statistics.peakFringeSize = 1;
+    }
+
+    while (remaining > 0 && !fringe.empty()) {
+        edge_weight_t minF = std::numeric_limits<edge_weight_t>::max();
+        if (Statistics) {
+            statistics.iterations++;
+        }
+
+        node_t current = fringe.first(data);
+        while (current != none) {
+
+            typename context_t::reference currentData = data(current);
+
+            edge_weight_t h;
+            if (currentData.h >= 0) {
+                h = currentData.h;
+                if (Statistics) {
+                    statistics.heuristicCacheHits++;
+                }
+            } else {
+                h = targets.estimate(graph, heuristic, current);
+                currentData.h = h;
+                if (Statistics) {
+                    statistics.heuristicCalls++;
+                }
+            }
+
+            edge_weight_t f = currentData.g + h;
+            if (Statistics) {
+                statistics.scanned++;
+            }
+
+            if (f > limit) {
+                if (f < minF) {
+                    minF = f;
+                }
+                if (Statistics) {
+                    statistics.deferred++;
+                }
+                current = fringe.defer(data, current);
+            } else {
+                // We reached a goal
+                if (targets.reach(graph, current)) {
+                    remaining--;
+                    if (remaining == 0) {
+                        break;
+                    }
+                }
+                // Expand children
+                edge_weight_t currentG = currentData.g;
+                edge_iterator last = SuccessorTraits<Graph>::getLast(graph, current, currentData.previousEdge);
+                for (edge_iterator it = SuccessorTraits<Graph>::getFirst(graph, current, currentData.previousEdge);
+                     it != last; ++it) {
+                    edge_t edge = graph.getEdge(it);
+                    edge_weight_t g = currentG + weight(graph, edge, currentG);
+
+                    node_t child = graph.getTarget(edge);
+                    node_id_t childIndex = graph.getIndex(child);
+
+                    if (Statistics) {
+                        statistics.relaxations++;
+                    }
+
+                    // Did we already consider this child?
+                    if (context->contains(childIndex)) {
+                        // Do not consider the child if a better route already exists
+                        if (g > (*context)[childIndex].g) {
+                            continue;
+                        }
+                        // Only a cheaper route to a node that already left the fringe reopens it
+                        if (Statistics && g < (*context)[childIndex].g && !fringe.contains(data, child)) {
+                            statistics.reopened++;
+                        }
+                    } else {
+                        context->initialize(childIndex);
+                    }
+                    typename context_t::reference childData = (*context)[childIndex];
+                    childData.previousEdge = edge;
+
+                    childData.g = g;
+
+                    if (Statistics && !fringe.contains(data, child)) {
+                        fringeSize++;
+                        statistics.peakFringeSize = std::max(statistics.peakFringeSize, fringeSize);
+                    }
+                    fringe.add(data, child);
+                }
+
+                if (Statistics) {
+                    statistics.expanded++;
+                    fringeSize--;
+                }
+                current = fringe.expand(data, current);
+            }
+        }
+
+        if (remaining == 0) {
+            break;
+        }
+
+        fringe.endIteration(data);
+        limit = minF;
+    }
+
+    return targets.size() - remaining;
+}
+
+#endif //USER_EQUILIBRIUM_FRINGESEARCHT_H
@@ -0,0 +1,180 @@
+#ifndef USER_EQUILIBRIUM_GEOMETRICHEURISTICS_H
+#define USER_EQUILIBRIUM_GEOMETRICHEURISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "FringeGraph.h"
+#include "GridFringeGraph.h"
+
+/*
+ * Geometric heuristic policies for FringeSearchT.
+ *
+ * The coordinates of all nodes are stored in a NodeCoordinates object, indexed
+ * the same way as search contexts, so evaluating a heuristic reads two floats
+ * per node from contiguous arrays instead of following pointers into the nodes.
+ *
+ * Distances are multiplied by a scale, which should be at most the lowest cost
+ * per unit of distance in the graph to keep the heuristic admissible.
+ */
+
+/**
+ * The coordinates of all nodes in a graph, as one array per axis.
+ *
+ * For HaversineHeuristic, x is the longitude and y the latitude, in degrees.
+ */
+struct NodeCoordinates {
+    // The x coordinate of every node, by node index
+    std::vector<edge_weight_t> x;
+
+    // The y coordinate of every node, by node index
+    std::vector<edge_weight_t> y;
+};
+
+/**
+ * Straight line distance, for graphs embedded in the plane.
+ */
+class EuclideanHeuristic {
+
+    const NodeCoordinates* coordinates;
+
+    edge_weight_t scale;
+
+public:
+    /**
+     * @param coordinates The node coordinates, must outlive this heuristic
+     * @param scale The cost per unit of distance
+     */
+    EuclideanHeuristic(const NodeCoordinates& coordinates, edge_weight_t scale = 1)
+            : coordinates(&coordinates), scale(scale) {}
+
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::node_t from, typename Graph::node_t to) const {
+        return estimate(graph.getIndex(from), graph.getIndex(to));
+    }
+
+    /**
+     * Estimate the cost between two nodes.
+     *
+     * @param from The index of the first node
+     * @param to The index of the second node
+     * @return The estimated cost
+     */
+    edge_weight_t estimate(node_id_t from, node_id_t to) const {
+        edge_weight_t dx = coordinates->x[from] - coordinates->x[to];
+        edge_weight_t dy = coordinates->y[from] - coordinates->y[to];
+        return scale * std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+/**
+ * Sum of the distances along both axes, for 4-connected grids.
+ */
+class ManhattanHeuristic {
+
+    const NodeCoordinates* coordinates;
+
+    edge_weight_t scale;
+
+public:
+    /**
+     * @param coordinates The node coordinates, must outlive this heuristic
+     * @param scale The cost per unit of distance
+     */
+    ManhattanHeuristic(const NodeCoordinates& coordinates, edge_weight_t scale = 1)
+            : coordinates(&coordinates), scale(scale) {}
+
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::node_t from, typename Graph::node_t to) const {
+        return estimate(graph.getIndex(from), graph.getIndex(to));
+    }
+
+    /**
+     * Estimate the cost between two nodes.
+     *
+     * @param from The index of the first node
+     * @param to The index of the second node
+     * @return The estimated cost
+     */
+    edge_weight_t estimate(node_id_t from, node_id_t to) const {
+        return scale * (std::abs(coordinates->x[from] - coordinates->x[to])
+                        + std::abs(coordinates->y[from] - coordinates->y[to]));
+    }
+};
+
+/**
+ * Distance with diagonal moves costing sqrt(2), for 8-connected grids.
+ */
+class OctileHeuristic {
+
+    const NodeCoordinates* coordinates;
+
+    edge_weight_t scale;
+
+public:
+    /**
+     * @param coordinates The node coordinates, must outlive this heuristic
+     * @param scale The cost per unit of distance
+     */
+    OctileHeuristic(const NodeCoordinates& coordinates, edge_weight_t scale = 1)
+            : coordinates(&coordinates), scale(scale) {}
+
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::node_t from, typename Graph::node_t to) const {
+        return estimate(graph.getIndex(from), graph.getIndex(to));
+    }
+
+    /**
+     * Estimate the cost between two nodes.
+     *
+     * @param from The index of the first node
+     * @param to The index of the second node
+     * @return The estimated cost
+     */
+    edge_weight_t estimate(node_id_t from, node_id_t to) const {
+        edge_weight_t dx = std::abs(coordinates->x[from] - coordinates->x[to]);
+        edge_weight_t dy = std::abs(coordinates->y[from] - coordinates->y[to]);
+        // Move diagonally along the shorter axis, each diagonal move costs sqrt(2) - 1 extra
+        return scale * (std::max(dx, dy) + (GridFringeGraph::DIAGONAL_COST - 1) * std::min(dx, dy));
+    }
+};
+
+/**
+ * Great circle distance, for road networks with longitude and latitude coordinates.
+ *
+ * The cosine of the latitude of every node is cached on construction.
+ */
+class HaversineHeuristic {
+
+    const NodeCoordinates* coordinates;
+
+    edge_weight_t scale;
+
+    // The cosine of the latitude of every node
+    std::vector<edge_weight_t> cosLatitudes;
+
+public:
+    /**
+     * @param coordinates The node coordinates, must outlive this heuristic
+     * @param scale The cost per unit of distance
+     * @param radius The radius of the sphere, in units of distance, the mean earth radius in meters by default
+     */
+    HaversineHeuristic(const NodeCoordinates& coordinates, edge_weight_t scale = 1, edge_weight_t radius = 6371000);
+
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::node_t from, typename Graph::node_t to) const {
+        return estimate(graph.getIndex(from), graph.getIndex(to));
+    }
+
+    /**
+     * Estimate the cost between two nodes.
+     *
+     * @param from The index of the first node
+     * @param to The index of the second node
+     * @return The estimated cost
+     */
+    edge_weight_t estimate(node_id_t from, node_id_t to) const;
+};
+
+#endif //USER_EQUILIBRIUM_GEOMETRICHEURISTICS_H
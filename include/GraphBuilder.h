@@ -0,0 +1,118 @@
+#ifndef USER_EQUILIBRIUM_GRAPHBUILDER_H
+#define USER_EQUILIBRIUM_GRAPHBUILDER_H
+
+#include <algorithm>
+#include <vector>
+
+#include "CompactFringeGraph.h"
+#include "FringeGraph.h"
+
+/**
+ * Builds a FringeGraph from an edge list in bulk.
+ *
+ * The degree of every node is counted before any edge is created, so every
+ * adjacency list is allocated exactly once, and nodes and edges are placed
+ * in the graph's arena in one linear pass over the edge list. Node IDs are
+ * the indices [0, getNodeCount()).
+ */
+class GraphBuilder {
+
+    node_id_t nodeCount;
+
+    std::vector<CompactFringeEdge> edges;
+
+public:
+    /**
+     * Create a builder without edges.
+     *
+     * @param nodeCount The minimum number of nodes to build, grows with the edges added
+     */
+    explicit GraphBuilder(node_id_t nodeCount = 0);
+
+    /**
+     * Create a builder for an edge list.
+     *
+     * @param nodeCount The minimum number of nodes to build, grows with the edges given
+     * @param edges The edges
+     */
+    GraphBuilder(node_id_t nodeCount, const std::vector<CompactFringeEdge>& edges);
+
+    /**
+     * Make room for more edges.
+     *
+     * @param edgeCount The number of edges to make room for
+     */
+    void reserve(std::size_t edgeCount);
+
+    /**
+     * Add an edge.
+     *
+     * @param from The source node ID
+     * @param to The target node ID
+     * @param weight The default weight
+     */
+    void addEdge(node_id_t from, node_id_t to, edge_weight_t weight);
+
+    /**
+     * Build at least the given number of nodes, even if they have no edges.
+     *
+     * @param nodeCount The minimum number of nodes to build
+     */
+    void setMinimumNodeCount(node_id_t nodeCount) {
+        this->nodeCount = std::max(this->nodeCount, nodeCount);
+    }
+
+    /**
+     * Get the number of nodes that will be built.
+     *
+     * @return The number of nodes
+     */
+    node_id_t getNodeCount() const {
+        return nodeCount;
+    }
+
+    /**
+     * Get the edges added so far, for example to build a CompactFringeGraph.
+     *
+     * @return The edges in the order they were added
+     */
+    const std::vector<CompactFringeEdge>& getEdges() const {
+        return edges;
+    }
+
+    /**
+     * Add all nodes and edges to a graph.
+     *
+     * Nodes with IDs the graph already contains are reused, the others are created.
+     * Edges are created in the order they were added to the builder.
+     *
+     * @tparam node_type The type of created nodes
+     * @tparam edge_type The type of created edges
+     * @param graph The graph to add to
+     */
+    template <class node_type = fringe_node_t, class edge_type = fringe_edge_t>
+    void build(FringeGraph& graph) const {
+        graph.reserveNodes(nodeCount);
+        for (node_id_t n = 0; n < nodeCount; n++) {
+            if (graph.getNode(n) == nullptr) {
+                graph.addNode<node_type>(n);
+            }
+        }
+
+        std::vector<node_id_t> incomingCounts;
+        std::vector<node_id_t> outgoingCounts;
+        countDegrees(incomingCounts, outgoingCounts);
+        for (node_id_t n = 0; n < nodeCount; n++) {
+            graph.getNode(n)->reserveEdges(incomingCounts[n], outgoingCounts[n]);
+        }
+
+        for (const CompactFringeEdge& edge : edges) {
+            graph.addEdge<edge_type>(graph.getNode(edge.from), graph.getNode(edge.to), edge.weight);
+        }
+    }
+
+private:
+    void countDegrees(std::vector<node_id_t>& incomingCounts, std::vector<node_id_t>& outgoingCounts) const;
+};
+
+#endif //USER_EQUILIBRIUM_GRAPHBUILDER_H
@@ -0,0 +1,109 @@
+#ifndef USER_EQUILIBRIUM_GRAPHIMPORTER_H
+#define USER_EQUILIBRIUM_GRAPHIMPORTER_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "FringeGraph.h"
+#include "GeometricHeuristics.h"
+#include "GraphBuilder.h"
+#include "GridFringeGraph.h"
+
+/**
+ * A query of a Moving AI scenario file.
+ */
+struct GridScenario {
+    // Groups queries of similar length
+    unsigned int bucket;
+
+    // The map file the query is for
+    std::string map;
+
+    // The size of the map
+    node_id_t width;
+    node_id_t height;
+
+    node_id_t startX;
+    node_id_t startY;
+
+    node_id_t goalX;
+    node_id_t goalY;
+
+    // The cost of the shortest path, with diagonal moves costing sqrt(2) and no corner cutting
+    double optimalLength;
+};
+
+/**
+ * Reads benchmark graphs in standard file formats.
+ *
+ * DIMACS files of the 9th Implementation Challenge (.gr graphs and .co
+ * coordinates) are read in chunks of whole lines, so memory besides the result
+ * is bounded by the chunk size times the number of threads. The chunks of a
+ * batch are parsed in parallel, then their results are added in file order,
+ * so the result is the same for any number of threads. DIMACS node IDs start
+ * at 1, imported node IDs start at 0.
+ *
+ * Moving AI grid maps (.map) and scenarios (.scen) are read line by line. Cells
+ * marked '.', 'G' or 'S' are passable with cost 1, all others are blocked, so
+ * the optimal lengths of the scenarios are the costs in the imported grid.
+ *
+ * All reads return false on malformed input, leaving the result in an unspecified state.
+ */
+class GraphImporter {
+
+    unsigned int threadCount;
+
+    std::size_t chunkSize;
+
+public:
+    // The default number of bytes read per chunk
+    static const std::size_t DEFAULT_CHUNK_SIZE = 1 << 22;
+
+    /**
+     * Create an importer.
+     *
+     * @param threadCount The number of threads to parse chunks with, 0 for one per hardware thread
+     * @param chunkSize The number of bytes to read per chunk, lines longer than this make their chunk longer
+     */
+    explicit GraphImporter(unsigned int threadCount = 0, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * Read a DIMACS graph (.gr) into a builder.
+     *
+     * @param in The stream to read
+     * @param builder The builder to add all arcs to, in file order
+     * @return True if the stream was a valid graph file
+     */
+    bool readDimacsGraph(std::istream& in, GraphBuilder& builder) const;
+
+    /**
+     * Read DIMACS node coordinates (.co).
+     *
+     * @param in The stream to read
+     * @param coordinates Receives the coordinates of all nodes, 0 for nodes the file does not list
+     * @return True if the stream was a valid coordinate file
+     */
+    bool readDimacsCoordinates(std::istream& in, NodeCoordinates& coordinates) const;
+
+    /**
+     * Read a Moving AI map (.map) as an 8-connected grid.
+     *
+     * @param in The stream to read
+     * @param grid Receives the grid
+     * @return True if the stream was a valid map file
+     */
+    bool readMovingAIMap(std::istream& in, GridFringeGraph& grid) const;
+
+    /**
+     * Read the queries of a Moving AI scenario (.scen).
+     *
+     * @param in The stream to read
+     * @param scenarios The list to append all queries to, in file order
+     * @return True if the stream was a valid scenario file
+     */
+    bool readMovingAIScenarios(std::istream& in, std::vector<GridScenario>& scenarios) const;
+};
+
+#endif //USER_EQUILIBRIUM_GRAPHIMPORTER_H
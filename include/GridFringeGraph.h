@@ -0,0 +1,361 @@
+#ifndef USER_EQUILIBRIUM_GRIDFRINGEGRAPH_H
+#define USER_EQUILIBRIUM_GRIDFRINGEGRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+#include "FringeGraph.h"
+
+/**
+ * An implicit graph over the cells of a 2D grid map.
+ *
+ * The map is stored as one cost byte per cell, 0 marks a blocked cell. Nodes
+ * are cell indices y * width + x, and edges are never stored: the edge in
+ * direction d from cell n has ID n * 8 + d, and neighbours are found with
+ * arithmetic on the index. Moving into a cell costs the cell's cost, times
+ * sqrt(2) for diagonal moves. Diagonal moves may not cut corners, so both
+ * cells next to the diagonal must be passable.
+ *
+ * Can be searched with FringeSearchT and BidirectionalFringeSearchT, for
+ * example with GridOctileHeuristic. Since cell costs are at least 1, the grid
+ * heuristics are admissible without scaling.
+ */
+class GridFringeGraph {
+public:
+    // The number of directions an edge can have
+    static const unsigned int DIRECTIONS = 8;
+
+    // The column and row difference of every direction: four straight, then four diagonal directions
+    static const int DX[DIRECTIONS];
+    static const int DY[DIRECTIONS];
+
+    // The cost of a diagonal move relative to a straight one, sqrt(2) rounded to the nearest float. Octile
+    // heuristics add DIAGONAL_COST - 1 per diagonal move, so they estimate with the same cost as the edges.
+    static constexpr edge_weight_t DIAGONAL_COST = 1.41421356f;
+
+    /**
+     * Iterates over the passable edges of a cell.
+     */
+    class EdgeIterator {
+
+        friend class GridFringeGraph;
+
+        const GridFringeGraph* graph;
+
+        node_id_t node;
+
+        // The cell's column and row, so they are only computed once per cell
+        node_id_t x;
+        node_id_t y;
+
+        unsigned int direction;
+
+        EdgeIterator(const GridFringeGraph* graph, node_id_t node, unsigned int direction)
+                : graph(graph), node(node), x(graph->getX(node)), y(graph->getY(node)), direction(direction) {
+            skip();
+        }
+
+        // Move on to the first passable direction from the current one
+        void skip() {
+            while (direction < graph->directionCount && !graph->hasEdge(node, x, y, direction)) {
+                direction++;
+            }
+        }
+
+    public:
+        edge_id_t operator*() const {
+            return node * DIRECTIONS + direction;
+        }
+
+        EdgeIterator& operator++() {
+            direction++;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const EdgeIterator& other) const {
+            return direction == other.direction;
+        }
+
+        bool operator!=(const EdgeIterator& other) const {
+            return direction != other.direction;
+        }
+    };
+
+    typedef node_id_t node_t;
+    typedef edge_id_t edge_t;
+    typedef EdgeIterator edge_iterator;
+    typedef EdgeIterator incoming_iterator;
+
+private:
+    node_id_t width;
+
+    node_id_t height;
+
+    // The cost of entering every cell, 0 if blocked
+    std::vector<uint8_t> costs;
+
+    // 4 for 4-connected grids, 8 if diagonal moves are allowed
+    unsigned int directionCount;
+
+    // The difference in cell index for every direction
+    int64_t offsets[DIRECTIONS];
+
+public:
+    /**
+     * Create a grid where every cell is passable with cost 1.
+     *
+     * @param width The number of columns
+     * @param height The number of rows
+     * @param diagonal Whether diagonal moves are allowed
+     */
+    GridFringeGraph(node_id_t width, node_id_t height, bool diagonal = true);
+
+    /**
+     * Create a grid from a cost map.
+     *
+     * @param width The number of columns
+     * @param height The number of rows
+     * @param costs The cost of entering every cell, row by row, 0 for blocked cells
+     * @param diagonal Whether diagonal moves are allowed
+     */
+    GridFringeGraph(node_id_t width, node_id_t height, const std::vector<uint8_t>& costs, bool diagonal = true);
+
+    /**
+     * Get the number of columns.
+     *
+     * @return The width
+     */
+    node_id_t getWidth() const {
+        return width;
+    }
+
+    /**
+     * Get the number of rows.
+     *
+     * @return The height
+     */
+    node_id_t getHeight() const {
+        return height;
+    }
+
+    /**
+     * Get the node of a cell.
+     *
+     * @param x The column
+     * @param y The row
+     * @return The node
+     */
+    node_id_t getNode(node_id_t x, node_id_t y) const {
+        return y * width + x;
+    }
+
+    /**
+     * Get the column of a node.
+     *
+     * @param node The node
+     * @return The column
+     */
+    node_id_t getX(node_id_t node) const {
+        return node % width;
+    }
+
+    /**
+     * Get the row of a node.
+     *
+     * @param node The node
+     * @return The row
+     */
+    node_id_t getY(node_id_t node) const {
+        return node / width;
+    }
+
+    /**
+     * Get the cost of entering a cell.
+     *
+     * @param node The node
+     * @return The cost, 0 if the cell is blocked
+     */
+    uint8_t getCost(node_id_t node) const {
+        return costs[node];
+    }
+
+    /**
+     * Set the cost of entering a cell.
+     *
+     * @param node The node
+     * @param cost The cost, 0 to block the cell
+     */
+    void setCost(node_id_t node, uint8_t cost) {
+        costs[node] = cost;
+    }
+
+    /**
+     * Check if there is an edge from a cell in a direction.
+     *
+     * @param node The node
+     * @param direction The direction, the edge ID modulo DIRECTIONS
+     * @return True if the move is inside the grid, into a passable cell and does not cut a corner
+     */
+    bool hasEdge(node_id_t node, unsigned int direction) const {
+        return hasEdge(node, getX(node), getY(node), direction);
+    }
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return The number of cells
+     */
+    node_id_t getNodeCount() const {
+        return width * height;
+    }
+
+    /**
+     * Get the number of bytes allocated for the grid's cell costs.
+     *
+     * @return The number of bytes
+     */
+    std::size_t getAllocatedBytes() const {
+        return costs.capacity() * sizeof(uint8_t);
+    }
+
+    /**
+     * Get the index of a node in a search context.
+     *
+     * @param node The node
+     * @return The node itself
+     */
+    node_id_t getIndex(node_id_t node) const {
+        return node;
+    }
+
+    /**
+     * Get an iterator to the first outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    edge_iterator getFirstOutgoing(node_id_t node) const {
+        return EdgeIterator(this, node, 0);
+    }
+
+    /**
+     * Get an iterator one past the last outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    edge_iterator getLastOutgoing(node_id_t node) const {
+        return EdgeIterator(this, node, directionCount);
+    }
+
+    /**
+     * Get the edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge ID
+     */
+    edge_id_t getEdge(edge_iterator it) const {
+        return *it;
+    }
+
+    /**
+     * Get an iterator to the first incoming edge of a node.
+     *
+     * Moves are symmetric, so this iterates over the outgoing edges and
+     * getIncomingEdge() reverses them.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getFirstIncoming(node_id_t node) const {
+        return EdgeIterator(this, node, 0);
+    }
+
+    /**
+     * Get an iterator one past the last incoming edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getLastIncoming(node_id_t node) const {
+        return EdgeIterator(this, node, directionCount);
+    }
+
+    /**
+     * Get the incoming edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge from the neighbour back to the iterated cell
+     */
+    edge_id_t getIncomingEdge(incoming_iterator it) const {
+        edge_id_t edge = *it;
+        unsigned int direction = edge % DIRECTIONS;
+        unsigned int opposite = direction < 4 ? direction ^ 1 : 11 - direction;
+        return getTarget(edge) * DIRECTIONS + opposite;
+    }
+
+    /**
+     * Get the source node of an edge.
+     *
+     * @param edge The edge
+     * @return The source node
+     */
+    node_id_t getSource(edge_id_t edge) const {
+        return edge / DIRECTIONS;
+    }
+
+    /**
+     * Get the target node of an edge.
+     *
+     * @param edge The edge
+     * @return The target node
+     */
+    node_id_t getTarget(edge_id_t edge) const {
+        return static_cast<node_id_t>(edge / DIRECTIONS + offsets[edge % DIRECTIONS]);
+    }
+
+    /**
+     * Get the weight of an edge.
+     *
+     * @param edge The edge
+     * @return The cost of the target cell, times sqrt(2) for diagonal edges
+     */
+    edge_weight_t getWeight(edge_id_t edge) const {
+        edge_weight_t cost = costs[getTarget(edge)];
+        return edge % DIRECTIONS < 4 ? cost : cost * DIAGONAL_COST;
+    }
+
+private:
+    bool hasEdge(node_id_t node, node_id_t x, node_id_t y, unsigned int direction) const;
+};
+
+/**
+ * Octile distance between grid cells, for 8-connected grids.
+ *
+ * Works on any graph with getX(node) and getY(node), such as JumpPointGraph.
+ */
+struct GridOctileHeuristic {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, node_id_t from, node_id_t to) const {
+        edge_weight_t dx = std::abs(static_cast<edge_weight_t>(graph.getX(from)) - graph.getX(to));
+        edge_weight_t dy = std::abs(static_cast<edge_weight_t>(graph.getY(from)) - graph.getY(to));
+        return std::max(dx, dy) + (GridFringeGraph::DIAGONAL_COST - 1) * std::min(dx, dy);
+    }
+};
+
+/**
+ * Manhattan distance between grid cells, for 4-connected grids.
+ */
+struct GridManhattanHeuristic {
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, node_id_t from, node_id_t to) const {
+        return std::abs(static_cast<edge_weight_t>(graph.getX(from)) - graph.getX(to))
+               + std::abs(static_cast<edge_weight_t>(graph.getY(from)) - graph.getY(to));
+    }
+};
+
+#endif //USER_EQUILIBRIUM_GRIDFRINGEGRAPH_H
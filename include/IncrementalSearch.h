@@ -0,0 +1,337 @@
+#ifndef USER_EQUILIBRIUM_INCREMENTALSEARCH_H
+#define USER_EQUILIBRIUM_INCREMENTALSEARCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "FringeGraph.h"
+#include "FringeSearchPolicies.h"
+#include "FringeSearchT.h"
+
+/**
+ * Incremental shortest path search that repairs its previous result after edge weight changes (D* Lite).
+ *
+ * The search runs backward from the end node, so every reached node keeps its
+ * cost to the end (g) and a one-step lookahead of that cost through its outgoing
+ * edges (rhs). After edge weights change, update() recomputes the lookahead of
+ * the edges' source nodes, and the next search() only expands nodes whose cost
+ * actually changed. The start node may move, for example along the path while
+ * it is being followed, without starting over.
+ *
+ * The graph type provides the members used by BidirectionalFringeSearchT. The
+ * heuristic must be consistent for the changed weights as well, and weights are
+ * calculated with a costToFrom of 0, as the cost to reach an edge is not known
+ * when searching backward. Weights must be positive for path() to find the
+ * path, zero weight cycles make it fail.
+ *
+ * @tparam Graph The graph type
+ * @tparam Heuristic The heuristic policy
+ * @tparam Weight The weight policy
+ */
+template <class Graph, class Heuristic = ZeroHeuristic, class Weight = DefaultWeight>
+class IncrementalSearchT {
+public:
+    typedef typename Graph::node_t node_t;
+    typedef typename Graph::edge_t edge_t;
+    typedef typename Graph::edge_iterator edge_iterator;
+    typedef typename Graph::incoming_iterator incoming_iterator;
+
+private:
+    // The relative difference up to which keys are considered equal to the start node's key
+    static constexpr edge_weight_t KEY_TOLERANCE = 1E-5f;
+
+    // The search data of a node, valid for the query with the same generation
+    struct NodeData {
+        // The cost from the node to the end node
+        edge_weight_t g;
+
+        // The cost through the best outgoing edge, g of the target plus the weight
+        edge_weight_t rhs;
+
+        uint32_t generation;
+    };
+
+    // Keys are ordered lexicographically, the queue may contain outdated entries
+    struct QueueEntry {
+        edge_weight_t key;
+        edge_weight_t tieBreak;
+        node_t node;
+
+        bool operator<(const QueueEntry& other) const {
+            return key < other.key || (key == other.key && tieBreak < other.tieBreak);
+        }
+
+        bool operator>(const QueueEntry& other) const {
+            return other < *this;
+        }
+    };
+
+    const Graph& graph;
+
+    Heuristic heuristic;
+
+    Weight weight;
+
+    std::vector<NodeData> data;
+
+    // The generation of the current query
+    uint32_t generation;
+
+    // Binary heap of inconsistent nodes, lowest key first
+    std::vector<QueueEntry> queue;
+
+    node_t start;
+
+    node_t end;
+
+    // The total heuristic distance the start node moved, added to all keys so older keys stay lower bounds
+    edge_weight_t keyModifier;
+
+public:
+    /**
+     * Create an incremental search instance, but do not initialize.
+     *
+     * Call reset() before calling search().
+     *
+     * @param graph The graph to search, must outlive this search
+     * @param heuristic The heuristic function
+     * @param weight The weight function
+     */
+    IncrementalSearchT(const Graph& graph, const Heuristic& heuristic = Heuristic(), const Weight& weight = Weight())
+            : graph(graph), heuristic(heuristic), weight(weight), data(graph.getNodeCount(), NodeData{0, 0, 0}),
+              generation(0) {}
+
+    /**
+     * Start a new query, forgetting all results of the previous one.
+     *
+     * @param start The starting node
+     * @param end The target node
+     */
+    void reset(node_t start, node_t end);
+
+    /**
+     * Move the starting node, keeping the results of the previous searches.
+     *
+     * @param start The new starting node
+     */
+    void moveStart(node_t start) {
+        keyModifier += heuristic(graph, this->start, start);
+        this->start = start;
+    }
+
+    /**
+     * Tell the search that edge weights changed since the last search.
+     *
+     * @param edges The edges with a different weight than before
+     */
+    void update(const std::vector<edge_t>& edges) {
+        for (edge_t edge : edges) {
+            node_t source = graph.getSource(edge);
+            if (source != end) {
+                edge_weight_t rhs = lookahead(source);
+                nodeData(source).rhs = rhs;
+                enqueue(source);
+            }
+        }
+    }
+
+    /**
+     * Find the cost from the starting node to the target node, repairing the previous result.
+     *
+     * @return The cost of the path, or infinity if there is no path
+     */
+    edge_weight_t search();
+
+    /**
+     * Get the path found by the last search and store it in a reusable buffer.
+     *
+     * @param path The buffer to store the path from start to end in, cleared if there is no path
+     * @return True if there is a path
+     */
+    bool path(PathBuffer<Graph>& path);
+
+private:
+    // Graphs that do not know their node count, such as pointer graphs, grow the data when needed,
+    // so references returned by this are only valid until the next call
+    NodeData& nodeData(node_t node) {
+        std::size_t index = graph.getIndex(node);
+        if (index >= data.size()) {
+            data.resize(std::max<std::size_t>(index + 1, data.size() * 2), NodeData{0, 0, 0});
+        }
+        NodeData& result = data[index];
+        if (result.generation != generation) {
+            result.g = std::numeric_limits<edge_weight_t>::infinity();
+            result.rhs = std::numeric_limits<edge_weight_t>::infinity();
+            result.generation = generation;
+        }
+        return result;
+    }
+
+    QueueEntry getKey(node_t node) {
+        const NodeData& current = nodeData(node);
+        edge_weight_t cost = std::min(current.g, current.rhs);
+        return {cost + heuristic(graph, start, node) + keyModifier, cost, node};
+    }
+
+    // Add an inconsistent node to the queue, consistent nodes are dropped from the queue when they reach its top
+    void enqueue(node_t node) {
+        const NodeData& current = nodeData(node);
+        if (current.g != current.rhs) {
+            queue.push_back(getKey(node));
+            std::push_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+        }
+    }
+
+    // The best cost to the end node through an outgoing edge
+    edge_weight_t lookahead(node_t node) {
+        edge_weight_t best = std::numeric_limits<edge_weight_t>::infinity();
+        edge_iterator last = graph.getLastOutgoing(node);
+        for (edge_iterator it = graph.getFirstOutgoing(node); it != last; ++it) {
+            edge_t edge = graph.getEdge(it);
+            best = std::min(best, weight(graph, edge, 0) + nodeData(graph.getTarget(edge)).g);
+        }
+        return best;
+    }
+};
+
+template <class Graph, class Heuristic, class Weight>
+void IncrementalSearchT<Graph, Heuristic, Weight>::reset(node_t start, node_t end) {
+    generation++;
+    if (generation == 0) {
+        // Stamps of old queries could match again, so clear them all
+        for (NodeData& current : data) {
+            current.generation = 0;
+        }
+        generation = 1;
+    }
+
+    this->start = start;
+    this->end = end;
+    keyModifier = 0;
+
+    queue.clear();
+    nodeData(end).rhs = 0;
+    enqueue(end);
+}
+
+template <class Graph, class Heuristic, class Weight>
+edge_weight_t IncrementalSearchT<Graph, Heuristic, Weight>::search() {
+    while (true) {
+        // Drop entries of nodes that became consistent after they were added
+        while (!queue.empty()) {
+            const NodeData& top = nodeData(queue.front().node);
+            if (top.g != top.rhs) {
+                break;
+            }
+            std::pop_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+            queue.pop_back();
+        }
+
+        // Stop once the start node is consistent and no remaining node can lead to a cheaper path. Keys
+        // collect rounding errors through the key modifier, so keys close to the start's are expanded as well.
+        const NodeData& startData = nodeData(start);
+        edge_weight_t limit = getKey(start).key * (1 + KEY_TOLERANCE);
+        if (queue.empty() || (queue.front().key > limit && startData.rhs == startData.g)) {
+            break;
+        }
+
+        std::pop_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+        QueueEntry entry = queue.back();
+        queue.pop_back();
+
+        node_t current = entry.node;
+        QueueEntry key = getKey(current);
+        if (entry < key) {
+            // The key was calculated for an earlier start node
+            queue.push_back(key);
+            std::push_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+            continue;
+        }
+
+        NodeData& currentData = nodeData(current);
+        incoming_iterator last = graph.getLastIncoming(current);
+        if (currentData.g > currentData.rhs) {
+            // The cost decreased, which can only improve the lookahead of predecessors
+            edge_weight_t g = currentData.rhs;
+            currentData.g = g;
+            for (incoming_iterator it = graph.getFirstIncoming(current); it != last; ++it) {
+                edge_t edge = graph.getIncomingEdge(it);
+                node_t previous = graph.getSource(edge);
+                NodeData& previousData = nodeData(previous);
+                edge_weight_t rhs = weight(graph, edge, 0) + g;
+                if (previous != end && rhs < previousData.rhs) {
+                    previousData.rhs = rhs;
+                    enqueue(previous);
+                }
+            }
+        } else {
+            // The cost increased, so predecessors that used it need a new lookahead
+            edge_weight_t oldG = currentData.g;
+            currentData.g = std::numeric_limits<edge_weight_t>::infinity();
+            for (incoming_iterator it = graph.getFirstIncoming(current); it != last; ++it) {
+                edge_t edge = graph.getIncomingEdge(it);
+                node_t previous = graph.getSource(edge);
+                NodeData& previousData = nodeData(previous);
+                if (previous != end && previousData.rhs == weight(graph, edge, 0) + oldG) {
+                    edge_weight_t rhs = lookahead(previous);
+                    nodeData(previous).rhs = rhs;
+                    enqueue(previous);
+                }
+            }
+            if (current != end) {
+                edge_weight_t rhs = lookahead(current);
+                nodeData(current).rhs = rhs;
+            }
+            enqueue(current);
+        }
+    }
+
+    return nodeData(start).g;
+}
+
+template <class Graph, class Heuristic, class Weight>
+bool IncrementalSearchT<Graph, Heuristic, Weight>::path(PathBuffer<Graph>& path) {
+    path.nodes.clear();
+    path.edges.clear();
+    if (nodeData(start).g == std::numeric_limits<edge_weight_t>::infinity()) {
+        return false;
+    }
+
+    // Follow the best outgoing edge, which leads to a node with a lower cost as weights are positive. With
+    // zero weight cycles the best edges can lead around a cycle, which is detected once the path has more
+    // nodes than were ever reached, as every node on it has search data.
+    node_t current = start;
+    path.nodes.push_back(current);
+    while (current != end) {
+        if (path.nodes.size() > data.size()) {
+            path.nodes.clear();
+            path.edges.clear();
+            return false;
+        }
+        edge_weight_t best = std::numeric_limits<edge_weight_t>::infinity();
+        edge_t bestEdge = edge_t();
+        edge_iterator last = graph.getLastOutgoing(current);
+        for (edge_iterator it = graph.getFirstOutgoing(current); it != last; ++it) {
+            edge_t edge = graph.getEdge(it);
+            edge_weight_t cost = weight(graph, edge, 0) + nodeData(graph.getTarget(edge)).g;
+            if (cost < best) {
+                best = cost;
+                bestEdge = edge;
+            }
+        }
+        if (best == std::numeric_limits<edge_weight_t>::infinity()) {
+            path.nodes.clear();
+            path.edges.clear();
+            return false;
+        }
+        current = graph.getTarget(bestEdge);
+        path.nodes.push_back(current);
+        path.edges.push_back(bestEdge);
+    }
+    return true;
+}
+
+#endif //USER_EQUILIBRIUM_INCREMENTALSEARCH_H
@@ -0,0 +1,345 @@
+#ifndef USER_EQUILIBRIUM_JUMPPOINTGRAPH_H
+#define USER_EQUILIBRIUM_JUMPPOINTGRAPH_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "FringeSearchT.h"
+#include "GridFringeGraph.h"
+
+/**
+ * A jump between two jump points of a grid, in a straight or diagonal line.
+ */
+struct JumpPointEdge {
+    node_id_t from;
+
+    node_id_t to;
+
+    // The cost of all moves of the jump
+    edge_weight_t weight;
+
+    // The direction of every move, as in GridFringeGraph
+    uint8_t direction;
+};
+
+template <>
+struct SearchNodeTraits<JumpPointEdge> {
+    /**
+     * @return The jump that marks the absence of an edge
+     */
+    static JumpPointEdge none() {
+        return {std::numeric_limits<node_id_t>::max(), std::numeric_limits<node_id_t>::max(), 0,
+                GridFringeGraph::DIRECTIONS};
+    }
+};
+
+/**
+ * Jump Point Search over an 8-connected GridFringeGraph.
+ *
+ * Instead of moving to the neighbouring cells, every node jumps in a straight
+ * line to the next jump point in each direction: the goal, a cell with a forced
+ * neighbour, or, for diagonal jumps, a cell from which a straight jump reaches
+ * one. Through SuccessorTraits, FringeSearchT only expands a node in the
+ * directions that can continue an optimal path from the direction it was reached
+ * in, so symmetric paths are never generated. Corners are not cut, as in the grid.
+ *
+ * This is only optimal if all passable cells have the same cost. Jump points
+ * depend on the goal, so set it before every search and search for that single
+ * target, or use JumpPointSearch.
+ */
+class JumpPointGraph {
+public:
+    /**
+     * Iterates over the jumps from a cell.
+     */
+    class JumpIterator {
+
+        friend class JumpPointGraph;
+
+        const JumpPointGraph* graph;
+
+        node_id_t node;
+
+        // The directions to jump in, one bit per direction
+        uint8_t directions;
+
+        unsigned int direction;
+
+        // The jump in the current direction
+        JumpPointEdge edge;
+
+        JumpIterator(const JumpPointGraph* graph, node_id_t node, uint8_t directions, unsigned int direction)
+                : graph(graph), node(node), directions(directions), direction(direction) {
+            skip();
+        }
+
+        // Move on to the first direction from the current one that reaches a jump point
+        void skip() {
+            while (direction < GridFringeGraph::DIRECTIONS
+                   && !((directions >> direction & 1) && graph->jump(node, direction, edge))) {
+                direction++;
+            }
+        }
+
+    public:
+        const JumpPointEdge& operator*() const {
+            return edge;
+        }
+
+        JumpIterator& operator++() {
+            direction++;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const JumpIterator& other) const {
+            return direction == other.direction;
+        }
+
+        bool operator!=(const JumpIterator& other) const {
+            return direction != other.direction;
+        }
+    };
+
+    typedef node_id_t node_t;
+    typedef JumpPointEdge edge_t;
+    typedef JumpIterator edge_iterator;
+
+private:
+    const GridFringeGraph& grid;
+
+    // The node every jump stops at
+    node_id_t goal;
+
+public:
+    /**
+     * Create a jump point view of a grid.
+     *
+     * @param grid The grid, must outlive this graph
+     */
+    explicit JumpPointGraph(const GridFringeGraph& grid)
+            : grid(grid), goal(SearchNodeTraits<node_id_t>::none()) {}
+
+    /**
+     * Get the grid.
+     *
+     * @return The grid
+     */
+    const GridFringeGraph& getGrid() const {
+        return grid;
+    }
+
+    /**
+     * Set the goal of the next search.
+     *
+     * @param goal The target node
+     */
+    void setGoal(node_id_t goal) {
+        this->goal = goal;
+    }
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return The number of cells
+     */
+    node_id_t getNodeCount() const {
+        return grid.getNodeCount();
+    }
+
+    /**
+     * Get the index of a node in a search context.
+     *
+     * @param node The node
+     * @return The node itself
+     */
+    node_id_t getIndex(node_id_t node) const {
+        return node;
+    }
+
+    /**
+     * Get the column of a node.
+     *
+     * @param node The node
+     * @return The column
+     */
+    node_id_t getX(node_id_t node) const {
+        return grid.getX(node);
+    }
+
+    /**
+     * Get the row of a node.
+     *
+     * @param node The node
+     * @return The row
+     */
+    node_id_t getY(node_id_t node) const {
+        return grid.getY(node);
+    }
+
+    /**
+     * Get an iterator to the first jump from a node in any direction.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    edge_iterator getFirstOutgoing(node_id_t node) const {
+        return JumpIterator(this, node, 0xFF, 0);
+    }
+
+    /**
+     * Get an iterator one past the last jump from a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    edge_iterator getLastOutgoing(node_id_t node) const {
+        return JumpIterator(this, node, 0, GridFringeGraph::DIRECTIONS);
+    }
+
+    /**
+     * Get an iterator to the first jump from a node that can continue an optimal path.
+     *
+     * @param node The node
+     * @param previous The jump the node was reached by, none for the start node
+     * @return The iterator
+     */
+    edge_iterator getFirstOutgoing(node_id_t node, const JumpPointEdge& previous) const {
+        return JumpIterator(this, node, getSuccessorDirections(previous.direction), 0);
+    }
+
+    /**
+     * Get the jump an iterator points to.
+     *
+     * @param it The iterator
+     * @return The jump
+     */
+    JumpPointEdge getEdge(const edge_iterator& it) const {
+        return *it;
+    }
+
+    /**
+     * Get the source node of a jump.
+     *
+     * @param edge The jump
+     * @return The source node
+     */
+    node_id_t getSource(const JumpPointEdge& edge) const {
+        return edge.from;
+    }
+
+    /**
+     * Get the target node of a jump.
+     *
+     * @param edge The jump
+     * @return The target node
+     */
+    node_id_t getTarget(const JumpPointEdge& edge) const {
+        return edge.to;
+    }
+
+    /**
+     * Get the weight of a jump.
+     *
+     * @param edge The jump
+     * @return The cost of all moves of the jump
+     */
+    edge_weight_t getWeight(const JumpPointEdge& edge) const {
+        return edge.weight;
+    }
+
+    /**
+     * Append the cells a jump moves through to a list.
+     *
+     * @param edge The jump
+     * @param cells The list to append all cells after the source, up to and including the target, to
+     */
+    void unpack(const JumpPointEdge& edge, std::vector<node_id_t>& cells) const;
+
+private:
+    static uint8_t getSuccessorDirections(unsigned int previousDirection);
+
+    bool jump(node_id_t node, unsigned int direction, JumpPointEdge& edge) const;
+
+    bool jumpStraight(int64_t x, int64_t y, int dx, int dy) const;
+
+    bool hasForcedNeighbour(int64_t x, int64_t y, int dx, int dy) const;
+
+    bool isPassable(int64_t x, int64_t y) const {
+        return x >= 0 && y >= 0 && x < grid.getWidth() && y < grid.getHeight()
+               && grid.getCost(static_cast<node_id_t>(y * grid.getWidth() + x)) != 0;
+    }
+};
+
+/**
+ * Expands JumpPointGraph nodes only in the directions that can continue an optimal path.
+ */
+template <>
+struct SuccessorTraits<JumpPointGraph> {
+    static JumpPointGraph::edge_iterator getFirst(const JumpPointGraph& graph, node_id_t node,
+                                                  const JumpPointEdge& previous) {
+        return graph.getFirstOutgoing(node, previous);
+    }
+
+    static JumpPointGraph::edge_iterator getLast(const JumpPointGraph& graph, node_id_t node,
+                                                 const JumpPointEdge& /*previous*/) {
+        return graph.getLastOutgoing(node);
+    }
+};
+
+/**
+ * Finds cell paths on a uniform-cost 8-connected grid with fringe search over jump points.
+ *
+ * Keeps its search data between searches, use one instance per thread.
+ */
+class JumpPointSearch {
+
+    JumpPointGraph graph;
+
+    FringeSearchT<JumpPointGraph, GridOctileHeuristic> fringeSearch;
+
+    // The jumps of the last path found
+    PathBuffer<JumpPointGraph> jumps;
+
+    // The cost of the last path found
+    edge_weight_t pathCost;
+
+public:
+    /**
+     * Create a search on a grid.
+     *
+     * @param grid The grid, must outlive this search
+     */
+    explicit JumpPointSearch(const GridFringeGraph& grid);
+
+    /**
+     * Search for a path between two cells.
+     *
+     * @param start The starting node
+     * @param end The target node
+     * @param path The list to store all cells from start to end in, cleared if no path was found
+     * @return True if a path was found
+     */
+    bool search(node_id_t start, node_id_t end, std::vector<node_id_t>& path);
+
+    /**
+     * Get the cost of the last path found.
+     *
+     * @return The cost of the path
+     */
+    edge_weight_t cost() const {
+        return pathCost;
+    }
+
+    /**
+     * Get the jump points of the last path found, the path only changes direction at these cells.
+     *
+     * @return The jump points from start to end and the jumps between them
+     */
+    const PathBuffer<JumpPointGraph>& getJumpPoints() const {
+        return jumps;
+    }
+};
+
+#endif //USER_EQUILIBRIUM_JUMPPOINTGRAPH_H
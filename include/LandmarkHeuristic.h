@@ -0,0 +1,113 @@
+#ifndef USER_EQUILIBRIUM_LANDMARKHEURISTIC_H
+#define USER_EQUILIBRIUM_LANDMARKHEURISTIC_H
+
+#include <cstddef>
+#include <vector>
+
+#include "CompactFringeGraph.h"
+#include "FringeGraph.h"
+
+/**
+ * How landmarks are selected.
+ */
+enum LandmarkSelection {
+    // Every landmark is the node farthest from the landmarks selected before
+    LANDMARKS_FARTHEST,
+    // Every landmark covers the part of a shortest path tree where the current bounds are worst
+    LANDMARKS_AVOID
+};
+
+/**
+ * Preprocessed distances between landmark nodes and all other nodes, for the
+ * ALT (A*, landmarks and triangle inequality) heuristic.
+ *
+ * By the triangle inequality, the cost from v to t is at least
+ * d(l, t) - d(l, v) and d(v, l) - d(t, l) for every landmark l. The estimate
+ * is the largest of these bounds over all landmarks, which is consistent.
+ *
+ * Distances are stored per node for all landmarks together, so an estimate
+ * reads two contiguous rows from both tables.
+ */
+class LandmarkTable {
+
+    node_id_t nodeCount;
+
+    std::vector<node_id_t> landmarks;
+
+    // The cost from every landmark to every node, at position node * landmark count + landmark
+    std::vector<edge_weight_t> fromLandmarks;
+
+    // The cost from every node to every landmark, at position node * landmark count + landmark
+    std::vector<edge_weight_t> toLandmarks;
+
+public:
+    /**
+     * Create a table without landmarks, estimating 0 everywhere.
+     */
+    LandmarkTable();
+
+    /**
+     * Select landmarks and compute their distance tables.
+     *
+     * Takes two single source shortest path computations per landmark, plus one
+     * per landmark for selecting with LANDMARKS_AVOID.
+     *
+     * @param graph The graph, search contexts must index nodes the same way
+     * @param landmarkCount The number of landmarks, at most the number of nodes. Landmarks are
+     *                      distinct, so fewer are selected if no other node is left.
+     * @param selection The selection strategy
+     * @param seed Seed for the random choices of the selection strategy
+     */
+    LandmarkTable(const CompactFringeGraph& graph, std::size_t landmarkCount,
+                  LandmarkSelection selection = LANDMARKS_AVOID, unsigned int seed = 0);
+
+    /**
+     * Get the selected landmarks.
+     *
+     * @return The landmark nodes
+     */
+    const std::vector<node_id_t>& getLandmarks() const {
+        return landmarks;
+    }
+
+    /**
+     * Get a lower bound on the cost between two nodes.
+     *
+     * @param from The index of the first node
+     * @param to The index of the second node
+     * @return The lower bound
+     */
+    edge_weight_t estimate(node_id_t from, node_id_t to) const;
+
+private:
+    void addLandmark(const CompactFringeGraph& graph, node_id_t landmark);
+
+    node_id_t selectFarthest(const CompactFringeGraph& graph, node_id_t root) const;
+
+    node_id_t selectAvoid(const CompactFringeGraph& graph, node_id_t root) const;
+};
+
+/**
+ * Heuristic policy estimating costs with a LandmarkTable.
+ *
+ * Works with any graph type whose getIndex() matches the indices of the graph
+ * the table was computed on, for example a PointerFringeGraph when the table was
+ * computed on a CompactFringeGraph built from nodes sorted by ID.
+ */
+class LandmarkHeuristic {
+
+    const LandmarkTable* table;
+
+public:
+    /**
+     * @param table The landmark table, must outlive this heuristic
+     */
+    LandmarkHeuristic(const LandmarkTable& table) : table(&table) {}
+
+    template <class Graph>
+    edge_weight_t operator()(const Graph& graph, typename Graph::node_t from, typename Graph::node_t to) const {
+        return table->estimate(graph.getIndex(from), graph.getIndex(to));
+    }
+};
+
+#endif //USER_EQUILIBRIUM_LANDMARKHEURISTIC_H
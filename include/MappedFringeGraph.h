@@ -0,0 +1,245 @@
+#ifndef USER_EQUILIBRIUM_MAPPEDFRINGEGRAPH_H
+#define USER_EQUILIBRIUM_MAPPEDFRINGEGRAPH_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "CompactFringeGraph.h"
+#include "FringeGraph.h"
+#include "GeometricHeuristics.h"
+
+/**
+ * A read-only graph searched in place in a memory-mapped binary file.
+ *
+ * The file holds the arrays of a CompactFringeGraph and optionally the node
+ * coordinates, each aligned to 64 bytes after a versioned header, in the byte
+ * order of the machine that wrote it. Opening a file only maps it and checks
+ * the header, so startup time does not depend on the size of the graph, and
+ * processes mapping the same file share its pages in the page cache. Edges
+ * are not validated, so only open files written by save().
+ *
+ * To store a graph of FringeNodes, build a CompactFringeGraph from its nodes
+ * first. Searched the same way as a CompactFringeGraph, see FringeSearchT.
+ */
+class MappedFringeGraph {
+
+    // The mapped file
+    void* mapping;
+    std::size_t mappingSize;
+
+    node_id_t nodeCount;
+    edge_id_t edgeCount;
+
+    // The arrays of a CompactFringeGraph, pointing into the mapped file
+    const edge_id_t* offsets;
+    const node_id_t* targets;
+    const edge_weight_t* weights;
+    const node_id_t* sources;
+    const edge_id_t* incomingOffsets;
+    const edge_id_t* incomingEdges;
+
+    // The node coordinates, nullptr if the file has none
+    const edge_weight_t* x;
+    const edge_weight_t* y;
+
+public:
+    typedef node_id_t node_t;
+    typedef edge_id_t edge_t;
+    typedef edge_id_t edge_iterator;
+    typedef const edge_id_t* incoming_iterator;
+
+    /**
+     * Create an empty graph, call open() to map a file.
+     */
+    MappedFringeGraph();
+
+    MappedFringeGraph(const MappedFringeGraph& other) = delete;
+
+    MappedFringeGraph& operator=(const MappedFringeGraph& other) = delete;
+
+    /**
+     * Unmap the file.
+     */
+    ~MappedFringeGraph();
+
+    /**
+     * Write a graph to a stream in the mapped format.
+     *
+     * @param out The stream to write to, opened in binary mode
+     * @param graph The graph
+     * @param coordinates The coordinates of all nodes to store as well, or nullptr
+     * @return True if writing succeeded
+     */
+    static bool save(std::ostream& out, const CompactFringeGraph& graph, const NodeCoordinates* coordinates = nullptr);
+
+    /**
+     * Map a graph file written by save(), replacing the currently mapped file.
+     *
+     * @param path The path of the file
+     * @return True if the file was mapped, false if it could not be mapped or is not a valid graph file
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Unmap the file, leaving an empty graph.
+     */
+    void close();
+
+    /**
+     * Check if the graph file has node coordinates.
+     *
+     * @return True if getX(), getY() and getCoordinates() can be used
+     */
+    bool hasCoordinates() const {
+        return x != nullptr;
+    }
+
+    /**
+     * Get the x coordinate of a node.
+     *
+     * @param node The node
+     * @return The x coordinate
+     */
+    edge_weight_t getX(node_id_t node) const {
+        return x[node];
+    }
+
+    /**
+     * Get the y coordinate of a node.
+     *
+     * @param node The node
+     * @return The y coordinate
+     */
+    edge_weight_t getY(node_id_t node) const {
+        return y[node];
+    }
+
+    /**
+     * Copy the node coordinates, for use with the geometric heuristics.
+     *
+     * @param coordinates Receives the coordinates of all nodes
+     * @return True if the file has coordinates
+     */
+    bool getCoordinates(NodeCoordinates& coordinates) const;
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return The number of nodes
+     */
+    node_id_t getNodeCount() const {
+        return nodeCount;
+    }
+
+    /**
+     * Get the number of edges.
+     *
+     * @return The number of edges
+     */
+    edge_id_t getEdgeCount() const {
+        return edgeCount;
+    }
+
+    /**
+     * Get the index of a node in a search context.
+     *
+     * @param node The node
+     * @return The node itself
+     */
+    node_id_t getIndex(node_id_t node) const {
+        return node;
+    }
+
+    /**
+     * Get the ID of the first outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The first outgoing edge
+     */
+    edge_id_t getFirstOutgoing(node_id_t node) const {
+        return offsets[node];
+    }
+
+    /**
+     * Get the ID one past the last outgoing edge of a node.
+     *
+     * @param node The node
+     * @return One past the last outgoing edge
+     */
+    edge_id_t getLastOutgoing(node_id_t node) const {
+        return offsets[node + 1];
+    }
+
+    /**
+     * Get the edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge ID, which is the iterator itself
+     */
+    edge_id_t getEdge(edge_id_t it) const {
+        return it;
+    }
+
+    /**
+     * Get an iterator to the first incoming edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getFirstIncoming(node_id_t node) const {
+        return incomingEdges + incomingOffsets[node];
+    }
+
+    /**
+     * Get an iterator one past the last incoming edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getLastIncoming(node_id_t node) const {
+        return incomingEdges + incomingOffsets[node + 1];
+    }
+
+    /**
+     * Get the incoming edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge ID
+     */
+    edge_id_t getIncomingEdge(incoming_iterator it) const {
+        return *it;
+    }
+
+    /**
+     * Get the source node of an edge.
+     *
+     * @param edge The edge
+     * @return The source node
+     */
+    node_id_t getSource(edge_id_t edge) const {
+        return sources[edge];
+    }
+
+    /**
+     * Get the target node of an edge.
+     *
+     * @param edge The edge
+     * @return The target node
+     */
+    node_id_t getTarget(edge_id_t edge) const {
+        return targets[edge];
+    }
+
+    /**
+     * Get the weight of an edge.
+     *
+     * @param edge The edge
+     * @return The weight
+     */
+    edge_weight_t getWeight(edge_id_t edge) const {
+        return weights[edge];
+    }
+};
+
+#endif //USER_EQUILIBRIUM_MAPPEDFRINGEGRAPH_H
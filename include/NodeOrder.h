@@ -0,0 +1,138 @@
+#ifndef USER_EQUILIBRIUM_NODEORDER_H
+#define USER_EQUILIBRIUM_NODEORDER_H
+
+#include <vector>
+
+#include "CompactFringeGraph.h"
+#include "FringeGraph.h"
+#include "GeometricHeuristics.h"
+
+/**
+ * A renumbering of the nodes of a graph that places nearby nodes close together in memory.
+ *
+ * Node indices of a CompactFringeGraph follow the order the nodes were given in,
+ * so the edges and search data of neighbouring nodes can be far apart. A search
+ * on the reordered graph returned by apply() touches fewer cache lines and pages.
+ * The order maps node indices between both graphs, so queries can be asked and
+ * answered in the original indices. Graphs built from FringeNodes keep their
+ * source nodes and edges, so getSourceNode() still finds the original nodes.
+ *
+ * Search costs are the same on both graphs. Tables built for a graph, such as
+ * landmarks or contraction hierarchies, must be built for the reordered graph.
+ */
+class NodeOrder {
+
+    // The original index of every reordered node
+    std::vector<node_id_t> originalIndices;
+
+    // The reordered index of every original node
+    std::vector<node_id_t> reorderedIndices;
+
+public:
+    /**
+     * Create an empty order.
+     */
+    NodeOrder();
+
+    /**
+     * Create an order from a list of all nodes.
+     *
+     * @param order The original index of every node in the new order, a permutation of all nodes
+     */
+    explicit NodeOrder(const std::vector<node_id_t>& order);
+
+    /**
+     * Order the nodes by a breadth-first search, ignoring edge directions.
+     *
+     * Nodes are numbered in the order they are reached, starting the search
+     * again from the first unreached node until all nodes are reached.
+     *
+     * @param graph The graph
+     * @return The order
+     */
+    static NodeOrder breadthFirst(const CompactFringeGraph& graph);
+
+    /**
+     * Order the nodes by the reverse Cuthill-McKee algorithm, ignoring edge directions.
+     *
+     * Reduces the bandwidth of the graph, the largest difference between the
+     * indices of two adjacent nodes: every component is searched breadth-first
+     * from a node far from the others, visiting the neighbours of every node
+     * in order of increasing degree, and the resulting order is reversed.
+     *
+     * @param graph The graph
+     * @return The order
+     */
+    static NodeOrder reverseCuthillMcKee(const CompactFringeGraph& graph);
+
+    /**
+     * Order the nodes along a Hilbert curve through their coordinates.
+     *
+     * Nodes that are close in the plane are close in the order, which suits
+     * road networks and other graphs whose edges connect nearby nodes.
+     *
+     * @param coordinates The coordinates of all nodes
+     * @return The order
+     */
+    static NodeOrder hilbertCurve(const NodeCoordinates& coordinates);
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return The number of nodes
+     */
+    node_id_t getNodeCount() const {
+        return static_cast<node_id_t>(originalIndices.size());
+    }
+
+    /**
+     * Get the index of a node in the reordered graph.
+     *
+     * @param node The index in the original graph
+     * @return The index in the reordered graph
+     */
+    node_id_t getReorderedIndex(node_id_t node) const {
+        return reorderedIndices[node];
+    }
+
+    /**
+     * Get the index of a node in the original graph.
+     *
+     * @param node The index in the reordered graph
+     * @return The index in the original graph
+     */
+    node_id_t getOriginalIndex(node_id_t node) const {
+        return originalIndices[node];
+    }
+
+    /**
+     * Map a list of nodes of the reordered graph, such as a path, to the original graph.
+     *
+     * @param nodes The nodes to replace by their original indices
+     */
+    void toOriginal(std::vector<node_id_t>& nodes) const {
+        for (node_id_t& node : nodes) {
+            node = originalIndices[node];
+        }
+    }
+
+    /**
+     * Build the reordered graph.
+     *
+     * @param graph The original graph
+     * @return The graph with its nodes renumbered by this order
+     */
+    CompactFringeGraph apply(const CompactFringeGraph& graph) const {
+        return graph.reorder(originalIndices);
+    }
+
+    /**
+     * Reorder node coordinates, for use with the reordered graph.
+     *
+     * @param coordinates The coordinates of the original nodes
+     * @return The coordinates of the reordered nodes
+     */
+    NodeCoordinates apply(const NodeCoordinates& coordinates) const;
+};
+
+#endif //USER_EQUILIBRIUM_NODEORDER_H
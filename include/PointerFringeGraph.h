@@ -0,0 +1,131 @@
+#ifndef USER_EQUILIBRIUM_POINTERFRINGEGRAPH_H
+#define USER_EQUILIBRIUM_POINTERFRINGEGRAPH_H
+
+#include <vector>
+
+#include "FringeGraph.h"
+
+/**
+ * Exposes a graph of BaseFringeNode and BaseFringeEdge objects to FringeSearchT.
+ *
+ * The adapter holds no state, nodes and edges are followed through their pointers.
+ * Nodes are indexed by their ID.
+ */
+class PointerFringeGraph {
+public:
+    typedef BaseFringeNode* node_t;
+    typedef BaseFringeEdge* edge_t;
+    typedef std::vector<BaseFringeEdge*>::const_iterator edge_iterator;
+    typedef std::vector<BaseFringeEdge*>::const_iterator incoming_iterator;
+
+    /**
+     * Get the number of nodes, unknown for a pointer graph.
+     *
+     * @return Always 0, so search contexts grow when needed
+     */
+    std::size_t getNodeCount() const {
+        return 0;
+    }
+
+    /**
+     * Get the index of a node in a search context.
+     *
+     * @param node The node
+     * @return The node's ID
+     */
+    node_id_t getIndex(node_t node) const {
+        return node->getID();
+    }
+
+    /**
+     * Get an iterator to the first outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    edge_iterator getFirstOutgoing(node_t node) const {
+        return node->getOutgoing().begin();
+    }
+
+    /**
+     * Get an iterator one past the last outgoing edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    edge_iterator getLastOutgoing(node_t node) const {
+        return node->getOutgoing().end();
+    }
+
+    /**
+     * Get the edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge
+     */
+    edge_t getEdge(edge_iterator it) const {
+        return *it;
+    }
+
+    /**
+     * Get an iterator to the first incoming edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getFirstIncoming(node_t node) const {
+        return node->getIncoming().begin();
+    }
+
+    /**
+     * Get an iterator one past the last incoming edge of a node.
+     *
+     * @param node The node
+     * @return The iterator
+     */
+    incoming_iterator getLastIncoming(node_t node) const {
+        return node->getIncoming().end();
+    }
+
+    /**
+     * Get the incoming edge an iterator points to.
+     *
+     * @param it The iterator
+     * @return The edge
+     */
+    edge_t getIncomingEdge(incoming_iterator it) const {
+        return *it;
+    }
+
+    /**
+     * Get the source node of an edge.
+     *
+     * @param edge The edge
+     * @return The source node
+     */
+    node_t getSource(edge_t edge) const {
+        return edge->getFrom();
+    }
+
+    /**
+     * Get the target node of an edge.
+     *
+     * @param edge The edge
+     * @return The target node
+     */
+    node_t getTarget(edge_t edge) const {
+        return edge->getTo();
+    }
+
+    /**
+     * Get the default weight of an edge.
+     *
+     * @param edge The edge
+     * @return The weight
+     */
+    edge_weight_t getWeight(edge_t edge) const {
+        return edge->getWeight();
+    }
+};
+
+#endif //USER_EQUILIBRIUM_POINTERFRINGEGRAPH_H
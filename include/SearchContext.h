@@ -0,0 +1,374 @@
+#ifndef USER_EQUILIBRIUM_SEARCHCONTEXT_H
+#define USER_EQUILIBRIUM_SEARCHCONTEXT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "FringeGraph.h"
+
+/**
+ * Describes how a node or edge is referred to during a search.
+ *
+ * @tparam node_t The node or edge reference type
+ */
+template <class node_t>
+struct SearchNodeTraits;
+
+template <>
+struct SearchNodeTraits<BaseFringeNode*> {
+    /**
+     * @return The reference that marks the absence of a node
+     */
+    static BaseFringeNode* none() {
+        return nullptr;
+    }
+};
+
+template <>
+struct SearchNodeTraits<BaseFringeEdge*> {
+    /**
+     * @return The reference that marks the absence of an edge
+     */
+    static BaseFringeEdge* none() {
+        return nullptr;
+    }
+};
+
+// Also used for edge_id_t, which is the same type
+template <>
+struct SearchNodeTraits<node_id_t> {
+    /**
+     * @return The reference that marks the absence of a node
+     */
+    static node_id_t none() {
+        return std::numeric_limits<node_id_t>::max();
+    }
+};
+
+/**
+ * The list of a split fringe a node belongs to.
+ *
+ * FRINGE_LISTED_LATER is a flag combined with the other states, set while the
+ * later list has an entry for the node, whichever list it belongs to now.
+ */
+enum FringeState : uint8_t {
+    FRINGE_NONE = 0,
+    FRINGE_NOW,
+    FRINGE_LATER,
+    FRINGE_LISTED_LATER = 4
+};
+
+/**
+ * The search state of a single node.
+ *
+ * @tparam node_t The node reference type
+ * @tparam edge_t The edge reference type
+ */
+template <class node_t, class edge_t>
+struct FringeSearchData {
+    // Current best edge from the previous node
+    edge_t previousEdge;
+    // Current best cost to get from start to this node
+    edge_weight_t g;
+    // Cached heuristic value
+    edge_weight_t h;
+    // Doubly linked list variables
+    node_t fringeNext;
+    node_t fringePrevious;
+    // Split fringe list membership
+    uint8_t fringeState;
+    // Generation of the search this data belongs to, 0 if it never belonged to one
+    uint32_t generation;
+};
+
+/**
+ * The state of a single search query, indexed by node ID.
+ *
+ * The search data of every node is stored in one FringeSearchData object.
+ * See ColumnarSearchContext for a layout that stores every field in its own array.
+ *
+ * A context is owned by the caller and used by one search at a time. Graphs
+ * are only read while searching, so any number of threads can search the same
+ * graph concurrently as long as every thread uses its own context.
+ *
+ * Search data is stamped with the generation of the search that initialized it,
+ * so starting a new search only increments the generation. The stamps are only
+ * cleared when the generation wraps around. Once a context is sized to the
+ * graph, reusing it for new searches does not allocate.
+ *
+ * @tparam node_t The node reference type
+ * @tparam edge_t The edge reference type
+ */
+template <class node_t, class edge_t>
+class BasicSearchContext {
+public:
+    // The type search data of a node is accessed through
+    typedef FringeSearchData<node_t, edge_t>& reference;
+
+private:
+    std::vector<FringeSearchData<node_t, edge_t>> data;
+
+    // The generation of the current search, used to see if search data was created by this search
+    uint32_t generation;
+
+public:
+    /**
+     * Create a context.
+     *
+     * @param nodeCount The number of nodes to reserve space for, the context grows when needed
+     */
+    BasicSearchContext(std::size_t nodeCount = 0) : generation(1) {
+        reserve(nodeCount);
+    }
+
+    /**
+     * Make sure the context can hold search data for the given number of nodes
+     * without growing during a search.
+     *
+     * @param nodeCount The number of nodes
+     */
+    void reserve(std::size_t nodeCount) {
+        if (nodeCount > data.size()) {
+            FringeSearchData<node_t, edge_t> empty = FringeSearchData<node_t, edge_t>();
+            empty.generation = 0;
+            data.resize(nodeCount, empty);
+        }
+    }
+
+    /**
+     * Get the number of nodes this context holds search data for.
+     *
+     * @return The number of nodes
+     */
+    std::size_t size() const {
+        return data.size();
+    }
+
+    /**
+     * Start a new search, invalidating all search data in constant time.
+     */
+    void begin() {
+        generation++;
+        if (generation == 0) {
+            // Stamps of old searches could match again, so clear them all
+            for (FringeSearchData<node_t, edge_t>& nodeData : data) {
+                nodeData.generation = 0;
+            }
+            generation = 1;
+        }
+    }
+
+    /**
+     * Check if a node was reached by the current search.
+     *
+     * @param id The node ID
+     * @return True if the node has search data for the current search
+     */
+    bool contains(node_id_t id) const {
+        return id < data.size() && data[id].generation == generation;
+    }
+
+    /**
+     * Initialize the search data of a node for the current search.
+     *
+     * May grow the context, invalidating references to search data.
+     *
+     * @param id The node ID
+     * @return The search data
+     */
+    FringeSearchData<node_t, edge_t>& initialize(node_id_t id) {
+        if (id >= data.size()) {
+            reserve(std::max<std::size_t>(id + 1, data.size() * 2));
+        }
+        FringeSearchData<node_t, edge_t>& nodeData = data[id];
+        nodeData.previousEdge = SearchNodeTraits<edge_t>::none();
+        nodeData.g = 0;
+        nodeData.h = -1;
+        nodeData.fringeNext = SearchNodeTraits<node_t>::none();
+        nodeData.fringePrevious = SearchNodeTraits<node_t>::none();
+        nodeData.fringeState = FRINGE_NONE;
+        nodeData.generation = generation;
+        return nodeData;
+    }
+
+    /**
+     * Get the search data of a node.
+     *
+     * Only valid if contains() returns true for the node.
+     *
+     * @param id The node ID
+     * @return The search data
+     */
+    FringeSearchData<node_t, edge_t>& operator[](node_id_t id) {
+        return data[id];
+    }
+
+    const FringeSearchData<node_t, edge_t>& operator[](node_id_t id) const {
+        return data[id];
+    }
+};
+
+/**
+ * References to the search state of a single node in a ColumnarSearchContext.
+ *
+ * Used like a FringeSearchData reference, but only the fields that are actually
+ * accessed are loaded.
+ *
+ * @tparam node_t The node reference type
+ * @tparam edge_t The edge reference type
+ */
+template <class node_t, class edge_t>
+struct FringeSearchDataReference {
+    edge_t& previousEdge;
+    edge_weight_t& g;
+    edge_weight_t& h;
+    node_t& fringeNext;
+    node_t& fringePrevious;
+    uint8_t& fringeState;
+};
+
+/**
+ * The state of a single search query, with every field stored in its own array indexed by node ID.
+ *
+ * Threshold scans only read the costs and heuristics of fringe nodes, which
+ * are stored densely instead of interleaved with the other fields. With
+ * CompactFringeGraph, whose nodes and edges are 32-bit indices, a node takes 25
+ * bytes of search data of which a scan reads 12. Otherwise it behaves like
+ * BasicSearchContext and can be used in its place.
+ *
+ * @tparam node_t The node reference type
+ * @tparam edge_t The edge reference type
+ */
+template <class node_t, class edge_t>
+class ColumnarSearchContext {
+public:
+    // The type search data of a node is accessed through
+    typedef FringeSearchDataReference<node_t, edge_t> reference;
+
+private:
+    // Current best edge from the previous node
+    std::vector<edge_t> previousEdges;
+
+    // Current best cost to get from start to the node
+    std::vector<edge_weight_t> costs;
+
+    // Cached heuristic values
+    std::vector<edge_weight_t> heuristics;
+
+    // Doubly linked list variables
+    std::vector<node_t> fringeNexts;
+    std::vector<node_t> fringePreviouses;
+
+    // Split fringe list membership
+    std::vector<uint8_t> fringeStates;
+
+    // Generation of the search the data belongs to, 0 if it never belonged to one
+    std::vector<uint32_t> generations;
+
+    // The generation of the current search
+    uint32_t generation;
+
+public:
+    /**
+     * Create a context.
+     *
+     * @param nodeCount The number of nodes to reserve space for, the context grows when needed
+     */
+    ColumnarSearchContext(std::size_t nodeCount = 0) : generation(1) {
+        reserve(nodeCount);
+    }
+
+    /**
+     * Make sure the context can hold search data for the given number of nodes
+     * without growing during a search.
+     *
+     * @param nodeCount The number of nodes
+     */
+    void reserve(std::size_t nodeCount) {
+        if (nodeCount > generations.size()) {
+            previousEdges.resize(nodeCount);
+            costs.resize(nodeCount);
+            heuristics.resize(nodeCount);
+            fringeNexts.resize(nodeCount);
+            fringePreviouses.resize(nodeCount);
+            fringeStates.resize(nodeCount);
+            generations.resize(nodeCount, 0);
+        }
+    }
+
+    /**
+     * Get the number of nodes this context holds search data for.
+     *
+     * @return The number of nodes
+     */
+    std::size_t size() const {
+        return generations.size();
+    }
+
+    /**
+     * Start a new search, invalidating all search data in constant time.
+     */
+    void begin() {
+        generation++;
+        if (generation == 0) {
+            // Stamps of old searches could match again, so clear them all
+            std::fill(generations.begin(), generations.end(), 0);
+            generation = 1;
+        }
+    }
+
+    /**
+     * Check if a node was reached by the current search.
+     *
+     * @param id The node ID
+     * @return True if the node has search data for the current search
+     */
+    bool contains(node_id_t id) const {
+        return id < generations.size() && generations[id] == generation;
+    }
+
+    /**
+     * Initialize the search data of a node for the current search.
+     *
+     * May grow the context, invalidating references to search data.
+     *
+     * @param id The node ID
+     * @return The search data
+     */
+    reference initialize(node_id_t id) {
+        if (id >= generations.size()) {
+            reserve(std::max<std::size_t>(id + 1, generations.size() * 2));
+        }
+        previousEdges[id] = SearchNodeTraits<edge_t>::none();
+        costs[id] = 0;
+        heuristics[id] = -1;
+        fringeNexts[id] = SearchNodeTraits<node_t>::none();
+        fringePreviouses[id] = SearchNodeTraits<node_t>::none();
+        fringeStates[id] = FRINGE_NONE;
+        generations[id] = generation;
+        return (*this)[id];
+    }
+
+    /**
+     * Get the search data of a node.
+     *
+     * Only valid if contains() returns true for the node.
+     *
+     * @param id The node ID
+     * @return The search data
+     */
+    reference operator[](node_id_t id) {
+        reference result = {previousEdges[id], costs[id], heuristics[id], fringeNexts[id], fringePreviouses[id],
+                            fringeStates[id]};
+        return result;
+    }
+};
+
+typedef BasicSearchContext<BaseFringeNode*, BaseFringeEdge*> SearchContext;
+typedef BasicSearchContext<node_id_t, edge_id_t> CompactSearchContext;
+typedef ColumnarSearchContext<node_id_t, edge_id_t> CompactColumnarSearchContext;
+
+#endif //USER_EQUILIBRIUM_SEARCHCONTEXT_H
@@ -0,0 +1,121 @@
+#include "CompactFringeGraph.h"
+
+#include <unordered_map>
+
+CompactFringeGraph::CompactFringeGraph() : offsets(1, 0), incomingOffsets(1, 0) {}
+
+CompactFringeGraph::CompactFringeGraph(node_id_t nodeCount, const std::vector<CompactFringeEdge> &edges) {
+    build(nodeCount, edges);
+}
+
+CompactFringeGraph::CompactFringeGraph(const std::vector<BaseFringeNode*> &nodes) : sourceNodes(nodes) {
+    std::unordered_map<BaseFringeNode*, node_id_t> indices;
+    indices.reserve(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        indices[nodes[i]] = static_cast<node_id_t>(i);
+    }
+
+    std::vector<CompactFringeEdge> edges;
+    std::vector<BaseFringeEdge*> edgeOrder;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        for (BaseFringeEdge* edge : nodes[i]->getOutgoing()) {
+            auto target = indices.find(edge->getTo());
+            if (target == indices.end()) {
+                continue;
+            }
+            edges.push_back({static_cast<node_id_t>(i), target->second, edge->getWeight()});
+            edgeOrder.push_back(edge);
+        }
+    }
+
+    // Edges are already grouped by source, so building keeps them in this order
+    build(static_cast<node_id_t>(nodes.size()), edges);
+    sourceEdges.swap(edgeOrder);
+}
+
+BaseFringeNode *CompactFringeGraph::getSourceNode(node_id_t node) const {
+    if (sourceNodes.empty()) {
+        return nullptr;
+    }
+    return sourceNodes[node];
+}
+
+BaseFringeEdge *CompactFringeGraph::getSourceEdge(edge_id_t edge) const {
+    if (sourceEdges.empty()) {
+        return nullptr;
+    }
+    return sourceEdges[edge];
+}
+
+std::size_t CompactFringeGraph::getAllocatedBytes() const {
+    return offsets.capacity() * sizeof(edge_id_t) + targets.capacity() * sizeof(node_id_t)
+           + weights.capacity() * sizeof(edge_weight_t) + sources.capacity() * sizeof(node_id_t)
+           + incomingOffsets.capacity() * sizeof(edge_id_t) + incomingEdges.capacity() * sizeof(edge_id_t)
+           + sourceNodes.capacity() * sizeof(BaseFringeNode*) + sourceEdges.capacity() * sizeof(BaseFringeEdge*);
+}
+
+CompactFringeGraph CompactFringeGraph::reorder(const std::vector<node_id_t> &order) const {
+    node_id_t nodeCount = getNodeCount();
+    std::vector<node_id_t> newIndices(nodeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        newIndices[order[n]] = n;
+    }
+
+    // Collect the edges grouped by their new source, so building keeps them in this order
+    CompactFringeGraph result;
+    std::vector<CompactFringeEdge> edges;
+    edges.reserve(getEdgeCount());
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        node_id_t node = order[n];
+        for (edge_id_t e = offsets[node]; e < offsets[node + 1]; e++) {
+            edges.push_back({n, newIndices[targets[e]], weights[e]});
+            if (!sourceEdges.empty()) {
+                result.sourceEdges.push_back(sourceEdges[e]);
+            }
+        }
+        if (!sourceNodes.empty()) {
+            result.sourceNodes.push_back(sourceNodes[node]);
+        }
+    }
+
+    result.build(nodeCount, edges);
+    return result;
+}
+
+void CompactFringeGraph::build(node_id_t nodeCount, const std::vector<CompactFringeEdge> &edges) {
+    // Count the out degree of every node, shifted by one so the prefix sum yields the offsets
+    offsets.assign(nodeCount + 1, 0);
+    for (const CompactFringeEdge& edge : edges) {
+        offsets[edge.from + 1]++;
+    }
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        offsets[n + 1] += offsets[n];
+    }
+
+    // Place every edge at the next free position of its source node
+    targets.resize(edges.size());
+    weights.resize(edges.size());
+    sources.resize(edges.size());
+    std::vector<edge_id_t> position(offsets.begin(), offsets.end() - 1);
+    for (const CompactFringeEdge& edge : edges) {
+        edge_id_t e = position[edge.from]++;
+        targets[e] = edge.to;
+        weights[e] = edge.weight;
+        sources[e] = edge.from;
+    }
+
+    // Group the edge IDs by target node the same way
+    incomingOffsets.assign(nodeCount + 1, 0);
+    for (const CompactFringeEdge& edge : edges) {
+        incomingOffsets[edge.to + 1]++;
+    }
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        incomingOffsets[n + 1] += incomingOffsets[n];
+    }
+
+    incomingEdges.resize(edges.size());
+    position.assign(incomingOffsets.begin(), incomingOffsets.end() - 1);
+    for (edge_id_t e = 0; e < targets.size(); e++) {
+        incomingEdges[position[targets[e]]++] = e;
+    }
+}
@@ -0,0 +1,601 @@
+#include "ContractionHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace {
+
+const edge_weight_t UNREACHABLE = std::numeric_limits<edge_weight_t>::infinity();
+
+typedef std::pair<edge_weight_t, node_id_t> queue_entry_t;
+typedef std::greater<queue_entry_t> queue_order_t;
+
+// An edge of the remaining graph during contraction, seen from one of its endpoints
+struct Neighbour {
+    node_id_t node;
+    edge_weight_t weight;
+    edge_id_t edge;
+};
+
+// The graph of all nodes that are not contracted yet, with at most one edge between two nodes
+struct RemainingGraph {
+    std::vector<std::vector<Neighbour>> outgoing;
+    std::vector<std::vector<Neighbour>> incoming;
+
+    // The number of contracted neighbours of every node, part of its priority
+    std::vector<int> contractedNeighbours;
+
+    // Add an edge, or replace the existing edge between the same nodes, unless that is not heavier
+    bool add(node_id_t from, node_id_t to, edge_weight_t weight, edge_id_t edge) {
+        for (Neighbour& neighbour : outgoing[from]) {
+            if (neighbour.node == to) {
+                if (weight >= neighbour.weight) {
+                    return false;
+                }
+                neighbour.weight = weight;
+                neighbour.edge = edge;
+                for (Neighbour& reverse : incoming[to]) {
+                    if (reverse.node == from) {
+                        reverse.weight = weight;
+                        reverse.edge = edge;
+                    }
+                }
+                return true;
+            }
+        }
+        outgoing[from].push_back({to, weight, edge});
+        incoming[to].push_back({from, weight, edge});
+        return true;
+    }
+
+    static void remove(std::vector<Neighbour>& neighbours, node_id_t node) {
+        for (std::size_t i = 0; i < neighbours.size(); i++) {
+            if (neighbours[i].node == node) {
+                neighbours[i] = neighbours.back();
+                neighbours.pop_back();
+                return;
+            }
+        }
+    }
+};
+
+/**
+ * Local Dijkstra searches that look for witness paths avoiding the node being contracted.
+ *
+ * Every thread uses its own instance.
+ */
+class WitnessSearch {
+
+    std::vector<edge_weight_t> distances;
+
+    std::vector<uint32_t> generations;
+
+    uint32_t generation;
+
+    std::vector<queue_entry_t> queue;
+
+    // Whether a node is a neighbour the node being contracted leads to, so searches can stop once all are settled
+    std::vector<uint8_t> isTarget;
+
+public:
+    WitnessSearch(node_id_t nodeCount)
+            : distances(nodeCount), generations(nodeCount, 0), generation(0), isTarget(nodeCount, 0) {}
+
+    /**
+     * Find the shortcuts needed to contract a node.
+     *
+     * @param shortcuts Receives the shortcuts, as hierarchy edges
+     */
+    void contract(const RemainingGraph& graph, node_id_t node, std::size_t limit,
+                  std::vector<ContractionHierarchy::Edge>& shortcuts) {
+        shortcuts.clear();
+        const std::vector<Neighbour>& outgoing = graph.outgoing[node];
+        edge_weight_t maxOutgoing = 0;
+        for (const Neighbour& out : outgoing) {
+            maxOutgoing = std::max(maxOutgoing, out.weight);
+        }
+
+        for (const Neighbour& out : outgoing) {
+            isTarget[out.node] = 1;
+        }
+        for (const Neighbour& in : graph.incoming[node]) {
+            search(graph, in.node, node, in.weight + maxOutgoing, limit, outgoing.size());
+            for (const Neighbour& out : outgoing) {
+                if (out.node == in.node) {
+                    continue;
+                }
+                // Equal-cost witnesses may run through another node contracted in the same round, so only a
+                // strictly shorter witness makes the shortcut unnecessary
+                edge_weight_t viaNode = in.weight + out.weight;
+                if (distance(out.node) >= viaNode) {
+                    shortcuts.push_back({in.node, out.node, viaNode, in.edge, out.edge});
+                }
+            }
+        }
+        for (const Neighbour& out : outgoing) {
+            isTarget[out.node] = 0;
+        }
+    }
+
+private:
+    edge_weight_t distance(node_id_t node) const {
+        return generations[node] == generation ? distances[node] : UNREACHABLE;
+    }
+
+    void search(const RemainingGraph& graph, node_id_t source, node_id_t avoid, edge_weight_t maxDistance,
+                std::size_t limit, std::size_t targetCount) {
+        generation++;
+        if (generation == 0) {
+            std::fill(generations.begin(), generations.end(), 0);
+            generation = 1;
+        }
+
+        queue.clear();
+        distances[source] = 0;
+        generations[source] = generation;
+        queue.push_back(queue_entry_t(0, source));
+
+        std::size_t settled = 0;
+        while (!queue.empty() && settled < limit && targetCount > 0) {
+            std::pop_heap(queue.begin(), queue.end(), queue_order_t());
+            queue_entry_t top = queue.back();
+            queue.pop_back();
+            if (top.first > distances[top.second]) {
+                continue;
+            }
+            if (top.first > maxDistance) {
+                break;
+            }
+            settled++;
+            if (isTarget[top.second]) {
+                targetCount--;
+            }
+
+            for (const Neighbour& out : graph.outgoing[top.second]) {
+                if (out.node == avoid) {
+                    continue;
+                }
+                edge_weight_t next = top.first + out.weight;
+                if (next < distance(out.node)) {
+                    distances[out.node] = next;
+                    generations[out.node] = generation;
+                    queue.push_back(queue_entry_t(next, out.node));
+                    std::push_heap(queue.begin(), queue.end(), queue_order_t());
+                }
+            }
+        }
+    }
+};
+
+// Call function(thread, i) for all i in [0, count) on threadCount threads
+template <class Function>
+void parallelFor(std::size_t count, unsigned int threadCount, const Function& function) {
+    std::atomic<std::size_t> next(0);
+    auto work = [&](unsigned int thread) {
+        for (std::size_t i = next++; i < count; i = next++) {
+            function(thread, i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount && t < count; t++) {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+const char MAGIC[4] = {'F', 'S', 'C', 'H'};
+const uint32_t FORMAT_VERSION = 2;
+
+// Arrays are written in the byte order and struct layout of the writer, so files from a different machine are rejected
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// The maximum number of values read at once, so a corrupt size fails at the end of the stream before allocating it
+const uint64_t READ_BLOCK_SIZE = 1 << 20;
+
+template <class T>
+void writeVector(std::ostream& out, const std::vector<T>& values) {
+    uint64_t size = values.size();
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <class T>
+bool readVector(std::istream& in, std::vector<T>& values) {
+    uint64_t size;
+    if (!in.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+        return false;
+    }
+    values.clear();
+    while (values.size() < size) {
+        std::size_t begin = values.size();
+        values.resize(begin + std::min(size - begin, READ_BLOCK_SIZE));
+        if (!in.read(reinterpret_cast<char*>(values.data() + begin), (values.size() - begin) * sizeof(T))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check that offsets group the adjacent edges of every node and that all of them exist
+bool isValidAdjacency(const std::vector<edge_id_t>& offsets, const std::vector<edge_id_t>& adjacent,
+                      std::size_t nodeCount, std::size_t edgeCount) {
+    if (offsets.size() != nodeCount + 1 || offsets[0] != 0 || offsets[nodeCount] != adjacent.size()) {
+        return false;
+    }
+    for (std::size_t n = 0; n < nodeCount; n++) {
+        if (offsets[n] > offsets[n + 1]) {
+            return false;
+        }
+    }
+    for (edge_id_t e : adjacent) {
+        if (e >= edgeCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+/*
+ * ContractionHierarchy implementation
+ */
+
+const edge_id_t ContractionHierarchy::NO_EDGE;
+
+ContractionHierarchy::ContractionHierarchy() : upOffsets(1, 0), downOffsets(1, 0) {}
+
+ContractionHierarchy::ContractionHierarchy(const CompactFringeGraph &graph, unsigned int threadCount,
+                                           std::size_t witnessLimit) {
+    node_id_t nodeCount = graph.getNodeCount();
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    RemainingGraph remaining;
+    remaining.outgoing.resize(nodeCount);
+    remaining.incoming.resize(nodeCount);
+    remaining.contractedNeighbours.assign(nodeCount, 0);
+    for (edge_id_t e = 0; e < graph.getEdgeCount(); e++) {
+        edges.push_back({graph.getSource(e), graph.getTarget(e), graph.getWeight(e), e, NO_EDGE});
+        if (graph.getSource(e) != graph.getTarget(e)) {
+            remaining.add(graph.getSource(e), graph.getTarget(e), graph.getWeight(e), e);
+        }
+    }
+
+    std::vector<WitnessSearch> witnessSearches(threadCount, WitnessSearch(nodeCount));
+    std::vector<std::vector<Edge>> threadShortcuts(threadCount);
+    std::vector<int> priorities(nodeCount);
+    auto updatePriority = [&](unsigned int thread, node_id_t node) {
+        std::vector<Edge>& shortcuts = threadShortcuts[thread];
+        witnessSearches[thread].contract(remaining, node, witnessLimit, shortcuts);
+        priorities[node] = static_cast<int>(shortcuts.size()) - static_cast<int>(remaining.incoming[node].size())
+                           - static_cast<int>(remaining.outgoing[node].size())
+                           + remaining.contractedNeighbours[node];
+    };
+
+    std::vector<node_id_t> uncontracted(nodeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        uncontracted[n] = n;
+    }
+    parallelFor(nodeCount, threadCount, [&](unsigned int thread, std::size_t i) {
+        updatePriority(thread, static_cast<node_id_t>(i));
+    });
+
+    ranks.assign(nodeCount, 0);
+    node_id_t nextRank = 0;
+    std::vector<edge_id_t> hierarchyEdges;
+    std::vector<uint8_t> selected(nodeCount, 0);
+    std::vector<uint8_t> touched(nodeCount, 0);
+
+    while (!uncontracted.empty()) {
+        // Select the nodes that are less important than all their neighbours, ties are broken by ID
+        auto lessImportant = [&](node_id_t a, node_id_t b) {
+            return priorities[a] < priorities[b] || (priorities[a] == priorities[b] && a < b);
+        };
+        parallelFor(uncontracted.size(), threadCount, [&](unsigned int /*thread*/, std::size_t i) {
+            node_id_t node = uncontracted[i];
+            bool independent = true;
+            for (const Neighbour& out : remaining.outgoing[node]) {
+                independent = independent && lessImportant(node, out.node);
+            }
+            for (const Neighbour& in : remaining.incoming[node]) {
+                independent = independent && lessImportant(node, in.node);
+            }
+            selected[node] = independent;
+        });
+        std::vector<node_id_t> contracting;
+        for (node_id_t node : uncontracted) {
+            if (selected[node]) {
+                contracting.push_back(node);
+            }
+        }
+
+        // Selected nodes are not adjacent, so their shortcuts can be found on the same graph in parallel
+        std::vector<std::vector<Edge>> shortcuts(contracting.size());
+        parallelFor(contracting.size(), threadCount, [&](unsigned int thread, std::size_t i) {
+            witnessSearches[thread].contract(remaining, contracting[i], witnessLimit, shortcuts[i]);
+        });
+
+        std::vector<node_id_t> neighbours;
+        for (std::size_t i = 0; i < contracting.size(); i++) {
+            node_id_t node = contracting[i];
+            ranks[node] = nextRank++;
+
+            // The edges left at a node lead to more important nodes
+            for (const Neighbour& out : remaining.outgoing[node]) {
+                hierarchyEdges.push_back(out.edge);
+                RemainingGraph::remove(remaining.incoming[out.node], node);
+                remaining.contractedNeighbours[out.node]++;
+                neighbours.push_back(out.node);
+            }
+            for (const Neighbour& in : remaining.incoming[node]) {
+                hierarchyEdges.push_back(in.edge);
+                RemainingGraph::remove(remaining.outgoing[in.node], node);
+                remaining.contractedNeighbours[in.node]++;
+                neighbours.push_back(in.node);
+            }
+            std::vector<Neighbour>().swap(remaining.outgoing[node]);
+            std::vector<Neighbour>().swap(remaining.incoming[node]);
+
+            for (const Edge& shortcut : shortcuts[i]) {
+                if (remaining.add(shortcut.from, shortcut.to, shortcut.weight, static_cast<edge_id_t>(edges.size()))) {
+                    edges.push_back(shortcut);
+                }
+            }
+        }
+
+        // Only the priorities of nodes next to contracted nodes changed
+        std::vector<node_id_t> updates;
+        for (node_id_t node : neighbours) {
+            if (!selected[node] && !touched[node]) {
+                touched[node] = 1;
+                updates.push_back(node);
+            }
+        }
+        parallelFor(updates.size(), threadCount, [&](unsigned int thread, std::size_t i) {
+            updatePriority(thread, updates[i]);
+        });
+        for (node_id_t node : updates) {
+            touched[node] = 0;
+        }
+
+        std::size_t size = 0;
+        for (node_id_t node : uncontracted) {
+            if (!selected[node]) {
+                uncontracted[size++] = node;
+            }
+        }
+        uncontracted.resize(size);
+    }
+
+    buildSearchGraph(hierarchyEdges);
+}
+
+std::size_t ContractionHierarchy::getShortcutCount() const {
+    std::size_t count = 0;
+    for (const Edge& edge : edges) {
+        if (edge.second != NO_EDGE) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void ContractionHierarchy::unpack(edge_id_t edge, std::vector<edge_id_t> &result) const {
+    const Edge& hierarchyEdge = edges[edge];
+    if (hierarchyEdge.second == NO_EDGE) {
+        result.push_back(hierarchyEdge.first);
+    } else {
+        unpack(hierarchyEdge.first, result);
+        unpack(hierarchyEdge.second, result);
+    }
+}
+
+bool ContractionHierarchy::save(std::ostream &out) const {
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(&FORMAT_VERSION), sizeof(FORMAT_VERSION));
+    out.write(reinterpret_cast<const char*>(&BYTE_ORDER_MARK), sizeof(BYTE_ORDER_MARK));
+    writeVector(out, ranks);
+    writeVector(out, edges);
+    writeVector(out, upOffsets);
+    writeVector(out, upEdges);
+    writeVector(out, downOffsets);
+    writeVector(out, downEdges);
+    return static_cast<bool>(out);
+}
+
+bool ContractionHierarchy::load(std::istream &in) {
+    char magic[sizeof(MAGIC)];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    bool success = in.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), MAGIC)
+                   && in.read(reinterpret_cast<char*>(&version), sizeof(version)) && version == FORMAT_VERSION
+                   && in.read(reinterpret_cast<char*>(&byteOrderMark), sizeof(byteOrderMark))
+                   && byteOrderMark == BYTE_ORDER_MARK
+                   && readVector(in, ranks) && readVector(in, edges)
+                   && readVector(in, upOffsets) && readVector(in, upEdges)
+                   && readVector(in, downOffsets) && readVector(in, downEdges)
+                   && ranks.size() <= NO_EDGE && edges.size() <= NO_EDGE
+                   && isValidAdjacency(upOffsets, upEdges, ranks.size(), edges.size())
+                   && isValidAdjacency(downOffsets, downEdges, ranks.size(), edges.size());
+
+    // Shortcuts are built from earlier edges, which also keeps unpack() from recursing forever
+    for (node_id_t rank : ranks) {
+        success = success && rank < ranks.size();
+    }
+    for (std::size_t e = 0; success && e < edges.size(); e++) {
+        const Edge& edge = edges[e];
+        success = edge.from < ranks.size() && edge.to < ranks.size()
+                  && (edge.second == NO_EDGE || (edge.first < e && edge.second < e));
+    }
+    if (!success) {
+        *this = ContractionHierarchy();
+    }
+    return success;
+}
+
+void ContractionHierarchy::buildSearchGraph(const std::vector<edge_id_t> &hierarchyEdges) {
+    node_id_t nodeCount = getNodeCount();
+
+    // Group the edges by their less important endpoint with a counting sort, as in CompactFringeGraph
+    upOffsets.assign(nodeCount + 1, 0);
+    downOffsets.assign(nodeCount + 1, 0);
+    for (edge_id_t e : hierarchyEdges) {
+        const Edge& edge = edges[e];
+        if (ranks[edge.from] < ranks[edge.to]) {
+            upOffsets[edge.from + 1]++;
+        } else {
+            downOffsets[edge.to + 1]++;
+        }
+    }
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        upOffsets[n + 1] += upOffsets[n];
+        downOffsets[n + 1] += downOffsets[n];
+    }
+
+    upEdges.resize(upOffsets[nodeCount]);
+    downEdges.resize(downOffsets[nodeCount]);
+    std::vector<edge_id_t> upPosition(upOffsets.begin(), upOffsets.end() - 1);
+    std::vector<edge_id_t> downPosition(downOffsets.begin(), downOffsets.end() - 1);
+    for (edge_id_t e : hierarchyEdges) {
+        const Edge& edge = edges[e];
+        if (ranks[edge.from] < ranks[edge.to]) {
+            upEdges[upPosition[edge.from]++] = e;
+        } else {
+            downEdges[downPosition[edge.to]++] = e;
+        }
+    }
+}
+
+/*
+ * ContractionHierarchyQuery implementation
+ */
+
+ContractionHierarchyQuery::ContractionHierarchyQuery(const ContractionHierarchy &hierarchy)
+        : hierarchy(hierarchy), generation(0), meeting(UINT32_MAX), best(UNREACHABLE) {
+    for (Direction* direction : {&forward, &backward}) {
+        direction->distances.resize(hierarchy.getNodeCount());
+        direction->previousEdges.resize(hierarchy.getNodeCount());
+        direction->generations.assign(hierarchy.getNodeCount(), 0);
+    }
+}
+
+edge_weight_t ContractionHierarchyQuery::search(node_id_t start, node_id_t end) {
+    begin();
+    best = UNREACHABLE;
+    meeting = UINT32_MAX;
+
+    relax(forward, start, 0, ContractionHierarchy::NO_EDGE);
+    relax(backward, end, 0, ContractionHierarchy::NO_EDGE);
+
+    // A direction is done once its closest node is no closer than the best path
+    while (true) {
+        bool forwardDone = forward.queue.empty() || forward.queue.front().first >= best;
+        bool backwardDone = backward.queue.empty() || backward.queue.front().first >= best;
+        if (forwardDone && backwardDone) {
+            break;
+        }
+        if (backwardDone || (!forwardDone && forward.queue.front().first <= backward.queue.front().first)) {
+            step(forward, backward, true);
+        } else {
+            step(backward, forward, false);
+        }
+    }
+    return best;
+}
+
+bool ContractionHierarchyQuery::path(std::vector<edge_id_t> &result) const {
+    result.clear();
+    if (meeting == UINT32_MAX) {
+        return false;
+    }
+
+    // Collect the upward edges from start to the meeting node in reverse
+    std::vector<edge_id_t> upward;
+    for (edge_id_t e = forward.previousEdges[meeting]; e != ContractionHierarchy::NO_EDGE;
+         e = forward.previousEdges[hierarchy.getEdge(e).from]) {
+        upward.push_back(e);
+    }
+    for (std::size_t i = upward.size(); i > 0; i--) {
+        hierarchy.unpack(upward[i - 1], result);
+    }
+
+    for (edge_id_t e = backward.previousEdges[meeting]; e != ContractionHierarchy::NO_EDGE;
+         e = backward.previousEdges[hierarchy.getEdge(e).to]) {
+        hierarchy.unpack(e, result);
+    }
+    return true;
+}
+
+bool ContractionHierarchyQuery::path(const CompactFringeGraph &graph, std::vector<BaseFringeEdge*> &result) const {
+    std::vector<edge_id_t> edges;
+    result.clear();
+    if (!path(edges)) {
+        return false;
+    }
+    for (edge_id_t edge : edges) {
+        result.push_back(graph.getSourceEdge(edge));
+    }
+    return true;
+}
+
+void ContractionHierarchyQuery::begin() {
+    generation++;
+    if (generation == 0) {
+        std::fill(forward.generations.begin(), forward.generations.end(), 0);
+        std::fill(backward.generations.begin(), backward.generations.end(), 0);
+        generation = 1;
+    }
+    forward.queue.clear();
+    backward.queue.clear();
+}
+
+void ContractionHierarchyQuery::step(Direction &self, const Direction &other, bool isForward) {
+    std::pop_heap(self.queue.begin(), self.queue.end(), queue_order_t());
+    queue_entry_t top = self.queue.back();
+    self.queue.pop_back();
+
+    node_id_t node = top.second;
+    edge_weight_t distance = top.first;
+    if (distance > self.distances[node]) {
+        return;
+    }
+
+    if (other.generations[node] == generation && distance + other.distances[node] < best) {
+        best = distance + other.distances[node];
+        meeting = node;
+    }
+
+    if (isForward) {
+        for (edge_id_t i = hierarchy.getFirstUp(node); i != hierarchy.getLastUp(node); i++) {
+            edge_id_t e = hierarchy.getUpEdge(i);
+            const ContractionHierarchy::Edge& edge = hierarchy.getEdge(e);
+            relax(self, edge.to, distance + edge.weight, e);
+        }
+    } else {
+        for (edge_id_t i = hierarchy.getFirstDown(node); i != hierarchy.getLastDown(node); i++) {
+            edge_id_t e = hierarchy.getDownEdge(i);
+            const ContractionHierarchy::Edge& edge = hierarchy.getEdge(e);
+            relax(self, edge.from, distance + edge.weight, e);
+        }
+    }
+}
+
+void ContractionHierarchyQuery::relax(Direction &self, node_id_t node, edge_weight_t distance, edge_id_t edge) {
+    if (self.generations[node] == generation && self.distances[node] <= distance) {
+        return;
+    }
+    self.distances[node] = distance;
+    self.previousEdges[node] = edge;
+    self.generations[node] = generation;
+    self.queue.push_back(queue_entry_t(distance, node));
+    std::push_heap(self.queue.begin(), self.queue.end(), queue_order_t());
+}
@@ -0,0 +1,41 @@
+#include "FringeArena.h"
+
+#include <cstdint>
+
+FringeArena::FringeArena(std::size_t blockSize)
+        : blockSize(blockSize), allocatedBytes(0), current(nullptr), remaining(0) {}
+
+FringeArena::~FringeArena() {
+    for (auto it = destructors.rbegin(); it != destructors.rend(); it++) {
+        it->destroy(it->object);
+    }
+    for (char* block : blocks) {
+        delete[] block;
+    }
+}
+
+void *FringeArena::allocate(std::size_t size, std::size_t alignment) {
+    std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) % alignment;
+
+    if (current == nullptr || padding + size > remaining) {
+        // Large allocations get a block of their own, so the current block can still be used
+        if (size + alignment > blockSize / 4) {
+            char* block = new char[size + alignment];
+            blocks.push_back(block);
+            allocatedBytes += size + alignment;
+            std::size_t blockPadding = (alignment - reinterpret_cast<std::uintptr_t>(block) % alignment) % alignment;
+            return block + blockPadding;
+        }
+
+        current = new char[blockSize];
+        blocks.push_back(current);
+        allocatedBytes += blockSize;
+        remaining = blockSize;
+        padding = (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) % alignment;
+    }
+
+    char* result = current + padding;
+    current += padding + size;
+    remaining -= padding + size;
+    return result;
+}
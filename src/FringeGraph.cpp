@@ -1,17 +1,11 @@
 
 #include "FringeGraph.h"
 
-// Default heuristic implementation, always underestimates so is admissible
-template <>
-edge_weight_t FringeSearchHeuristic<void>::h(FringeNode<void>* from, FringeNode<void>* to) {
-    return 0;
-}
-
 /*
  * FringeNode implementation
  */
 
-BaseFringeNode::BaseFringeNode(node_id_t id) : id(id), fringeSearchData(nullptr) {}
+BaseFringeNode::BaseFringeNode(node_id_t id) : id(id) {}
 
 BaseFringeNode::~BaseFringeNode() {}
 
@@ -23,18 +17,6 @@ BaseFringeNode &BaseFringeNode::operator=(const BaseFringeNode &other) {
     return *this;
 }
 
-node_id_t BaseFringeNode::getID() {
-    return id;
-}
-
-std::vector<BaseFringeEdge*> &BaseFringeNode::getIncoming() {
-    return incoming;
-}
-
-std::vector<BaseFringeEdge*> &BaseFringeNode::getOutgoing() {
-    return outgoing;
-}
-
 BaseFringeEdge *BaseFringeNode::getIncident(BaseFringeNode* other) {
     for (BaseFringeEdge* edge : getOutgoing()) {
         if (edge->getTo() == other) {
@@ -56,10 +38,9 @@ edge_weight_t BaseFringeNode::calculateHeuristic(BaseFringeNode *to) {
     return 0;
 }
 
-// Default edge weight calculation implementation, always returns the default weight
-template <>
-edge_weight_t FringeEdgeWeightCalculation<void>::weight(FringeEdge<void>* edge, edge_weight_t costToFrom) {
-    return edge->getWeight();
+void BaseFringeNode::reserveEdges(std::size_t incomingCount, std::size_t outgoingCount) {
+    incoming.reserve(incoming.size() + incomingCount);
+    outgoing.reserve(outgoing.size() + outgoingCount);
 }
 
 /*
@@ -88,35 +69,29 @@ edge_weight_t BaseFringeEdge::calculateWeight(edge_weight_t costToFrom) {
     return getWeight();
 }
 
-edge_id_t BaseFringeEdge::getID() {
-    return id;
-}
-
-BaseFringeNode* BaseFringeEdge::getFrom() {
-    return from;
-}
-
 void BaseFringeEdge::setFrom(BaseFringeNode *node) {
     from = node;
     node->addOutgoing(this);
 }
 
-BaseFringeNode* BaseFringeEdge::getTo() {
-    return to;
-}
-
 void BaseFringeEdge::setTo(BaseFringeNode *node) {
     to = node;
     node->addIncoming(this);
 }
 
-edge_weight_t BaseFringeEdge::getWeight() {
-    return weight;
-}
-
 void BaseFringeEdge::setWeight(edge_weight_t weight) {
     this->weight = weight;
 }
 
+/*
+ * FringeGraph implementation
+ */
 
+FringeGraph::FringeGraph(std::size_t blockSize) : arena(blockSize), edgeCount(0) {}
 
+void FringeGraph::reserveNodes(node_id_t nodeCount) {
+    nodes.reserve(nodeCount);
+    if (nodeCount > nodesById.size()) {
+        nodesById.resize(nodeCount, nullptr);
+    }
+}
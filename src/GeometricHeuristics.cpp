@@ -0,0 +1,24 @@
+#include "GeometricHeuristics.h"
+
+/*
+ * HaversineHeuristic implementation
+ */
+
+static const edge_weight_t DEGREES_TO_RADIANS = 0.017453292f;
+
+HaversineHeuristic::HaversineHeuristic(const NodeCoordinates &coordinates, edge_weight_t scale,
+                                       edge_weight_t radius)
+        : coordinates(&coordinates), scale(scale * radius) {
+    cosLatitudes.resize(coordinates.y.size());
+    for (std::size_t n = 0; n < coordinates.y.size(); n++) {
+        cosLatitudes[n] = std::cos(coordinates.y[n] * DEGREES_TO_RADIANS);
+    }
+}
+
+edge_weight_t HaversineHeuristic::estimate(node_id_t from, node_id_t to) const {
+    edge_weight_t sinLatitude = std::sin((coordinates->y[from] - coordinates->y[to]) * DEGREES_TO_RADIANS / 2);
+    edge_weight_t sinLongitude = std::sin((coordinates->x[from] - coordinates->x[to]) * DEGREES_TO_RADIANS / 2);
+    edge_weight_t a = sinLatitude * sinLatitude
+                      + cosLatitudes[from] * cosLatitudes[to] * sinLongitude * sinLongitude;
+    return 2 * scale * std::asin(std::sqrt(std::min(a, 1.0f)));
+}
@@ -0,0 +1,38 @@
+#include "GraphBuilder.h"
+
+GraphBuilder::GraphBuilder(node_id_t nodeCount) : nodeCount(nodeCount) {}
+
+GraphBuilder::GraphBuilder(node_id_t nodeCount, const std::vector<CompactFringeEdge> &edges)
+        : nodeCount(nodeCount), edges(edges) {
+    for (const CompactFringeEdge& edge : edges) {
+        if (edge.from >= this->nodeCount) {
+            this->nodeCount = edge.from + 1;
+        }
+        if (edge.to >= this->nodeCount) {
+            this->nodeCount = edge.to + 1;
+        }
+    }
+}
+
+void GraphBuilder::reserve(std::size_t edgeCount) {
+    edges.reserve(edges.size() + edgeCount);
+}
+
+void GraphBuilder::addEdge(node_id_t from, node_id_t to, edge_weight_t weight) {
+    edges.push_back({from, to, weight});
+    if (from >= nodeCount) {
+        nodeCount = from + 1;
+    }
+    if (to >= nodeCount) {
+        nodeCount = to + 1;
+    }
+}
+
+void GraphBuilder::countDegrees(std::vector<node_id_t> &incomingCounts, std::vector<node_id_t> &outgoingCounts) const {
+    incomingCounts.assign(nodeCount, 0);
+    outgoingCounts.assign(nodeCount, 0);
+    for (const CompactFringeEdge& edge : edges) {
+        incomingCounts[edge.to]++;
+        outgoingCounts[edge.from]++;
+    }
+}
@@ -0,0 +1,450 @@
+#include "GraphImporter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// Reads a stream in chunks of whole lines
+class ChunkReader {
+
+    std::istream& in;
+
+    std::size_t chunkSize;
+
+    // The start of the line that did not fit into the previous chunk
+    std::string carry;
+
+public:
+    ChunkReader(std::istream& in, std::size_t chunkSize) : in(in), chunkSize(chunkSize) {}
+
+    // Read the next chunk, false once the stream is exhausted
+    bool next(std::string& chunk) {
+        chunk.swap(carry);
+        carry.clear();
+        while (in) {
+            std::size_t size = chunk.size();
+            chunk.resize(size + chunkSize);
+            in.read(&chunk[size], chunkSize);
+            chunk.resize(size + static_cast<std::size_t>(in.gcount()));
+            if (!in) {
+                // The rest of the stream is the last chunk
+                break;
+            }
+            std::size_t lineEnd = chunk.rfind('\n');
+            if (lineEnd != std::string::npos) {
+                carry.assign(chunk, lineEnd + 1, std::string::npos);
+                chunk.resize(lineEnd + 1);
+                return true;
+            }
+        }
+        return !chunk.empty();
+    }
+};
+
+// Reads the fields of the lines of a chunk
+class LineParser {
+
+    const char* position;
+
+    const char* end;
+
+public:
+    explicit LineParser(const std::string& chunk) : position(chunk.data()), end(chunk.data() + chunk.size()) {}
+
+    bool atEnd() const {
+        return position == end;
+    }
+
+    // Get the first character of the rest of the line, '\n' at the end of a line or chunk
+    char peek() {
+        skipBlanks();
+        return position == end ? '\n' : *position;
+    }
+
+    // Move past the next character
+    void skip() {
+        position++;
+    }
+
+    // Move to the start of the next line
+    void skipLine() {
+        const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        position = lineEnd == nullptr ? end : lineEnd + 1;
+    }
+
+    // Move to the start of the next line, false if the line has more fields
+    bool endLine() {
+        if (peek() != '\n') {
+            return false;
+        }
+        if (position != end) {
+            position++;
+        }
+        return true;
+    }
+
+    bool readWord(std::string& word) {
+        skipBlanks();
+        const char* start = position;
+        while (position != end && !std::isspace(static_cast<unsigned char>(*position))) {
+            position++;
+        }
+        word.assign(start, position);
+        return !word.empty();
+    }
+
+    bool readUnsigned(uint64_t& value) {
+        skipBlanks();
+        if (position == end || *position < '0' || *position > '9') {
+            return false;
+        }
+        value = 0;
+        while (position != end && *position >= '0' && *position <= '9') {
+            if (value > (std::numeric_limits<uint64_t>::max() - 9) / 10) {
+                return false;
+            }
+            value = value * 10 + (*position++ - '0');
+        }
+        return true;
+    }
+
+    bool readNumber(double& value) {
+        // strtod skips line breaks, so make sure the number starts on this line
+        skipBlanks();
+        if (position == end || !std::strchr("+-.0123456789", *position)) {
+            return false;
+        }
+        char* numberEnd;
+        value = std::strtod(position, &numberEnd);
+        if (numberEnd == position || numberEnd > end || !std::isfinite(value)) {
+            return false;
+        }
+        position = numberEnd;
+        return true;
+    }
+
+private:
+    void skipBlanks() {
+        while (position != end && (*position == ' ' || *position == '\t' || *position == '\r')) {
+            position++;
+        }
+    }
+};
+
+/*
+ * Read a stream in batches of one chunk per thread, parse the chunks of a batch
+ * in parallel with parse(chunk, result), then merge their results in file order
+ * with merge(result). Both return false for malformed input.
+ */
+template <class Result, class Parse, class Merge>
+bool parseChunks(std::istream& in, unsigned int threadCount, std::size_t chunkSize, const Parse& parse,
+                 const Merge& merge) {
+    ChunkReader reader(in, chunkSize);
+    std::vector<std::string> chunks(threadCount);
+    std::vector<Result> results(threadCount);
+    std::vector<char> valid(threadCount);
+    auto work = [&](unsigned int thread) {
+        results[thread] = Result();
+        valid[thread] = parse(chunks[thread], results[thread]);
+    };
+
+    bool more = true;
+    while (more) {
+        unsigned int count = 0;
+        while (count < threadCount && (more = reader.next(chunks[count]))) {
+            count++;
+        }
+
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < count; t++) {
+            threads.emplace_back(work, t);
+        }
+        if (count > 0) {
+            work(0);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (unsigned int t = 0; t < count; t++) {
+            if (!valid[t] || !merge(results[t])) {
+                return false;
+            }
+        }
+    }
+    return !in.bad();
+}
+
+// A DIMACS problem line, "p sp <nodes> <arcs>" for graphs or "p aux sp co <nodes>" for coordinates
+struct ProblemLine {
+    bool found;
+    uint64_t nodeCount;
+    uint64_t itemCount;
+};
+
+bool readProblemLine(LineParser& parser, ProblemLine& problem, bool coordinates) {
+    std::string word;
+    if (problem.found) {
+        return false;
+    }
+    problem.found = true;
+    if (coordinates) {
+        problem.itemCount = 0;
+        return parser.readWord(word) && word == "aux" && parser.readWord(word) && word == "sp"
+               && parser.readWord(word) && word == "co" && parser.readUnsigned(problem.nodeCount)
+               && problem.nodeCount <= std::numeric_limits<node_id_t>::max() && parser.endLine();
+    }
+    return parser.readWord(word) && word == "sp" && parser.readUnsigned(problem.nodeCount)
+           && parser.readUnsigned(problem.itemCount) && problem.nodeCount <= std::numeric_limits<node_id_t>::max()
+           && parser.endLine();
+}
+
+// A DIMACS node ID, converted to start at 0
+bool readNodeId(LineParser& parser, node_id_t& node) {
+    uint64_t id;
+    if (!parser.readUnsigned(id) || id == 0 || id > std::numeric_limits<node_id_t>::max()) {
+        return false;
+    }
+    node = static_cast<node_id_t>(id - 1);
+    return true;
+}
+
+struct GraphChunk {
+    ProblemLine problem;
+
+    std::vector<CompactFringeEdge> arcs;
+};
+
+struct Vertex {
+    node_id_t node;
+    edge_weight_t x;
+    edge_weight_t y;
+};
+
+struct CoordinateChunk {
+    ProblemLine problem;
+
+    std::vector<Vertex> vertices;
+};
+
+// Parse the lines of a chunk, calling readLine(parser, type) for all lines except comments and blank lines
+template <class ReadLine>
+bool parseLines(const std::string& chunk, const ReadLine& readLine) {
+    LineParser parser(chunk);
+    while (!parser.atEnd()) {
+        char type = parser.peek();
+        if (type == 'c') {
+            parser.skipLine();
+        } else if (type == '\n') {
+            parser.endLine();
+        } else {
+            parser.skip();
+            if (!readLine(parser, type)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool isPassable(char cell) {
+    return cell == '.' || cell == 'G' || cell == 'S';
+}
+
+// Read a line without the line break, removing the carriage return of Windows line breaks
+bool readLine(std::istream& in, std::string& line) {
+    if (!std::getline(in, line)) {
+        return false;
+    }
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    return true;
+}
+
+}
+
+GraphImporter::GraphImporter(unsigned int threadCount, std::size_t chunkSize)
+        : threadCount(threadCount), chunkSize(std::max<std::size_t>(chunkSize, 1)) {
+    if (this->threadCount == 0) {
+        this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+bool GraphImporter::readDimacsGraph(std::istream &in, GraphBuilder &builder) const {
+    auto parse = [](const std::string& chunk, GraphChunk& result) {
+        return parseLines(chunk, [&](LineParser& parser, char type) {
+            if (type == 'p') {
+                return readProblemLine(parser, result.problem, false);
+            }
+            CompactFringeEdge arc;
+            double weight;
+            if (type != 'a' || !readNodeId(parser, arc.from) || !readNodeId(parser, arc.to)
+                || !parser.readNumber(weight) || weight < 0 || !parser.endLine()) {
+                return false;
+            }
+            arc.weight = static_cast<edge_weight_t>(weight);
+            result.arcs.push_back(arc);
+            return true;
+        });
+    };
+
+    // The problem line comes before all arcs, so it is merged before them
+    ProblemLine problem = {false, 0, 0};
+    uint64_t arcCount = 0;
+    auto merge = [&](const GraphChunk& result) {
+        if (result.problem.found) {
+            if (problem.found) {
+                return false;
+            }
+            problem = result.problem;
+            builder.setMinimumNodeCount(static_cast<node_id_t>(problem.nodeCount));
+            builder.reserve(problem.itemCount);
+        }
+        if (!result.arcs.empty() && !problem.found) {
+            return false;
+        }
+        for (const CompactFringeEdge& arc : result.arcs) {
+            if (arc.from >= problem.nodeCount || arc.to >= problem.nodeCount) {
+                return false;
+            }
+            builder.addEdge(arc.from, arc.to, arc.weight);
+        }
+        arcCount += result.arcs.size();
+        return true;
+    };
+
+    return parseChunks<GraphChunk>(in, threadCount, chunkSize, parse, merge) && problem.found
+           && arcCount == problem.itemCount;
+}
+
+bool GraphImporter::readDimacsCoordinates(std::istream &in, NodeCoordinates &coordinates) const {
+    auto parse = [](const std::string& chunk, CoordinateChunk& result) {
+        return parseLines(chunk, [&](LineParser& parser, char type) {
+            if (type == 'p') {
+                return readProblemLine(parser, result.problem, true);
+            }
+            Vertex vertex;
+            double x;
+            double y;
+            if (type != 'v' || !readNodeId(parser, vertex.node) || !parser.readNumber(x) || !parser.readNumber(y)
+                || !parser.endLine()) {
+                return false;
+            }
+            vertex.x = static_cast<edge_weight_t>(x);
+            vertex.y = static_cast<edge_weight_t>(y);
+            result.vertices.push_back(vertex);
+            return true;
+        });
+    };
+
+    ProblemLine problem = {false, 0, 0};
+    auto merge = [&](const CoordinateChunk& result) {
+        if (result.problem.found) {
+            if (problem.found) {
+                return false;
+            }
+            problem = result.problem;
+            coordinates.x.assign(problem.nodeCount, 0);
+            coordinates.y.assign(problem.nodeCount, 0);
+        }
+        if (!result.vertices.empty() && !problem.found) {
+            return false;
+        }
+        for (const Vertex& vertex : result.vertices) {
+            if (vertex.node >= problem.nodeCount) {
+                return false;
+            }
+            coordinates.x[vertex.node] = vertex.x;
+            coordinates.y[vertex.node] = vertex.y;
+        }
+        return true;
+    };
+
+    return parseChunks<CoordinateChunk>(in, threadCount, chunkSize, parse, merge) && problem.found;
+}
+
+bool GraphImporter::readMovingAIMap(std::istream &in, GridFringeGraph &grid) const {
+    // The header lists the type, height and width in any order, then "map" starts the cells
+    uint64_t width = 0;
+    uint64_t height = 0;
+    std::string line;
+    while (readLine(in, line) && line != "map") {
+        std::istringstream fields(line);
+        std::string key;
+        std::string value;
+        if (!(fields >> key >> value)) {
+            return false;
+        }
+        if (key == "type") {
+            if (value != "octile") {
+                return false;
+            }
+        } else if (key == "height" || key == "width") {
+            char* valueEnd;
+            uint64_t size = std::strtoull(value.c_str(), &valueEnd, 10);
+            if (*valueEnd != '\0') {
+                return false;
+            }
+            (key == "height" ? height : width) = size;
+        } else {
+            return false;
+        }
+    }
+    if (line != "map" || width == 0 || height == 0 || width > std::numeric_limits<node_id_t>::max() / height) {
+        return false;
+    }
+
+    std::vector<uint8_t> costs;
+    costs.reserve(width * height);
+    for (uint64_t y = 0; y < height; y++) {
+        if (!readLine(in, line) || line.size() != width) {
+            return false;
+        }
+        for (char cell : line) {
+            costs.push_back(isPassable(cell) ? 1 : 0);
+        }
+    }
+
+    grid = GridFringeGraph(static_cast<node_id_t>(width), static_cast<node_id_t>(height), costs);
+    return true;
+}
+
+bool GraphImporter::readMovingAIScenarios(std::istream &in, std::vector<GridScenario> &scenarios) const {
+    std::string line;
+    bool first = true;
+    while (readLine(in, line)) {
+        std::istringstream fields(line);
+        std::string word;
+        if (!(fields >> word)) {
+            // Blank line
+            continue;
+        }
+        if (first && word == "version") {
+            first = false;
+            continue;
+        }
+        first = false;
+
+        GridScenario scenario;
+        fields.str(line);
+        fields.clear();
+        if (!(fields >> scenario.bucket >> scenario.map >> scenario.width >> scenario.height
+                     >> scenario.startX >> scenario.startY >> scenario.goalX >> scenario.goalY
+                     >> scenario.optimalLength) || (fields >> word)
+            || scenario.startX >= scenario.width || scenario.goalX >= scenario.width
+            || scenario.startY >= scenario.height || scenario.goalY >= scenario.height) {
+            return false;
+        }
+        scenarios.push_back(scenario);
+    }
+    return !in.bad();
+}
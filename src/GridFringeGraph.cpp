@@ -0,0 +1,28 @@
+#include "GridFringeGraph.h"
+
+const unsigned int GridFringeGraph::DIRECTIONS;
+
+const int GridFringeGraph::DX[GridFringeGraph::DIRECTIONS] = {1, -1, 0, 0, 1, -1, 1, -1};
+const int GridFringeGraph::DY[GridFringeGraph::DIRECTIONS] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr edge_weight_t GridFringeGraph::DIAGONAL_COST;
+
+GridFringeGraph::GridFringeGraph(node_id_t width, node_id_t height, bool diagonal)
+        : GridFringeGraph(width, height, std::vector<uint8_t>(width * height, 1), diagonal) {}
+
+GridFringeGraph::GridFringeGraph(node_id_t width, node_id_t height, const std::vector<uint8_t> &costs,
+                                 bool diagonal)
+        : width(width), height(height), costs(costs), directionCount(diagonal ? 8 : 4) {
+    for (unsigned int d = 0; d < DIRECTIONS; d++) {
+        offsets[d] = DY[d] * static_cast<int64_t>(width) + DX[d];
+    }
+}
+
+bool GridFringeGraph::hasEdge(node_id_t node, node_id_t x, node_id_t y, unsigned int direction) const {
+    int64_t toX = static_cast<int64_t>(x) + DX[direction];
+    int64_t toY = static_cast<int64_t>(y) + DY[direction];
+    if (toX < 0 || toY < 0 || toX >= width || toY >= height || costs[node + offsets[direction]] == 0) {
+        return false;
+    }
+    // Diagonal moves may not cut corners, so both cells next to the move must be passable
+    return direction < 4 || (costs[node + DX[direction]] != 0 && costs[node + offsets[DY[direction] > 0 ? 2 : 3]] != 0);
+}
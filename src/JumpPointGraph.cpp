@@ -0,0 +1,120 @@
+#include "JumpPointGraph.h"
+
+namespace {
+
+// The direction of every column and row difference, indexed by (dy + 1) * 3 + dx + 1
+const unsigned int DIRECTION_OF[9] = {7, 3, 6, 1, GridFringeGraph::DIRECTIONS, 0, 5, 2, 4};
+
+uint8_t directionBit(int dx, int dy) {
+    return static_cast<uint8_t>(1 << DIRECTION_OF[(dy + 1) * 3 + dx + 1]);
+}
+
+}
+
+void JumpPointGraph::unpack(const JumpPointEdge &edge, std::vector<node_id_t> &cells) const {
+    int64_t offset = static_cast<int64_t>(GridFringeGraph::DY[edge.direction]) * grid.getWidth()
+                     + GridFringeGraph::DX[edge.direction];
+    for (node_id_t cell = edge.from; cell != edge.to;) {
+        cell = static_cast<node_id_t>(cell + offset);
+        cells.push_back(cell);
+    }
+}
+
+uint8_t JumpPointGraph::getSuccessorDirections(unsigned int previousDirection) {
+    // The start node has no direction to prune with
+    if (previousDirection >= GridFringeGraph::DIRECTIONS) {
+        return 0xFF;
+    }
+
+    int dx = GridFringeGraph::DX[previousDirection];
+    int dy = GridFringeGraph::DY[previousDirection];
+    if (dx != 0 && dy != 0) {
+        // Diagonal: keep going, or turn to either straight direction it consists of
+        return directionBit(dx, dy) | directionBit(dx, 0) | directionBit(0, dy);
+    }
+    // Straight: keep going, or turn sideways around an obstacle that ends here. Without corner
+    // cutting, the cells to the side can be forced neighbours as well, so they are always tried.
+    if (dy == 0) {
+        return directionBit(dx, 0) | directionBit(dx, 1) | directionBit(dx, -1) | directionBit(0, 1)
+               | directionBit(0, -1);
+    }
+    return directionBit(0, dy) | directionBit(1, dy) | directionBit(-1, dy) | directionBit(1, 0)
+           | directionBit(-1, 0);
+}
+
+bool JumpPointGraph::jump(node_id_t node, unsigned int direction, JumpPointEdge &edge) const {
+    int dx = GridFringeGraph::DX[direction];
+    int dy = GridFringeGraph::DY[direction];
+    bool diagonal = direction >= 4;
+    int64_t offset = static_cast<int64_t>(dy) * grid.getWidth() + dx;
+
+    int64_t x = grid.getX(node);
+    int64_t y = grid.getY(node);
+    node_id_t current = node;
+    node_id_t steps = 0;
+    while (true) {
+        if (!isPassable(x + dx, y + dy) || (diagonal && (!isPassable(x + dx, y) || !isPassable(x, y + dy)))) {
+            return false;
+        }
+        x += dx;
+        y += dy;
+        current = static_cast<node_id_t>(current + offset);
+        steps++;
+
+        if (current == goal) {
+            break;
+        }
+        // A diagonal jump stops where one of its straight directions reaches a jump point
+        if (diagonal ? jumpStraight(x, y, dx, 0) || jumpStraight(x, y, 0, dy) : hasForcedNeighbour(x, y, dx, dy)) {
+            break;
+        }
+    }
+
+    edge_weight_t cost = grid.getCost(current);
+    edge_weight_t weight = steps * (diagonal ? cost * GridFringeGraph::DIAGONAL_COST : cost);
+    edge = {node, current, weight, static_cast<uint8_t>(direction)};
+    return true;
+}
+
+bool JumpPointGraph::jumpStraight(int64_t x, int64_t y, int dx, int dy) const {
+    while (isPassable(x + dx, y + dy)) {
+        x += dx;
+        y += dy;
+        if (static_cast<node_id_t>(y * grid.getWidth() + x) == goal || hasForcedNeighbour(x, y, dx, dy)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JumpPointGraph::hasForcedNeighbour(int64_t x, int64_t y, int dx, int dy) const {
+    // A passable cell to the side is forced if the cell behind it is blocked, as it can not be reached
+    // diagonally from the previous cell without cutting that corner
+    if (dx != 0) {
+        return (isPassable(x, y - 1) && !isPassable(x - dx, y - 1))
+               || (isPassable(x, y + 1) && !isPassable(x - dx, y + 1));
+    }
+    return (isPassable(x - 1, y) && !isPassable(x - 1, y - dy))
+           || (isPassable(x + 1, y) && !isPassable(x + 1, y - dy));
+}
+
+JumpPointSearch::JumpPointSearch(const GridFringeGraph &grid)
+        : graph(grid), fringeSearch(graph), pathCost(std::numeric_limits<edge_weight_t>::infinity()) {}
+
+bool JumpPointSearch::search(node_id_t start, node_id_t end, std::vector<node_id_t> &path) {
+    graph.setGoal(end);
+    fringeSearch.reset(start);
+
+    path.clear();
+    if (!fringeSearch.search(end, jumps)) {
+        pathCost = std::numeric_limits<edge_weight_t>::infinity();
+        return false;
+    }
+    pathCost = fringeSearch.cost(end);
+
+    path.push_back(start);
+    for (const JumpPointEdge& edge : jumps.edges) {
+        graph.unpack(edge, path);
+    }
+    return true;
+}
@@ -0,0 +1,234 @@
+#include "LandmarkHeuristic.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+
+namespace {
+
+const edge_weight_t UNREACHABLE = std::numeric_limits<edge_weight_t>::infinity();
+
+// Returned by the selection strategies when every node is a landmark already
+const node_id_t NO_LANDMARK = std::numeric_limits<node_id_t>::max();
+
+/**
+ * Compute the cost from source to every node, or from every node to source if backward.
+ *
+ * @param order Receives the reached nodes in order of increasing cost, if not nullptr
+ * @param parents Receives the previous node on the shortest path of every reached node, if not nullptr
+ */
+void shortestPaths(const CompactFringeGraph& graph, node_id_t source, bool backward,
+                   std::vector<edge_weight_t>& distances, std::vector<node_id_t>* order,
+                   std::vector<node_id_t>* parents) {
+    typedef std::pair<edge_weight_t, node_id_t> entry_t;
+    std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> queue;
+
+    distances.assign(graph.getNodeCount(), UNREACHABLE);
+    if (parents != nullptr) {
+        parents->assign(graph.getNodeCount(), source);
+    }
+    distances[source] = 0;
+    queue.push(entry_t(0, source));
+
+    while (!queue.empty()) {
+        entry_t top = queue.top();
+        queue.pop();
+        node_id_t node = top.second;
+        if (top.first > distances[node]) {
+            continue;
+        }
+        if (order != nullptr) {
+            order->push_back(node);
+        }
+
+        if (backward) {
+            for (CompactFringeGraph::incoming_iterator it = graph.getFirstIncoming(node);
+                 it != graph.getLastIncoming(node); ++it) {
+                edge_id_t edge = graph.getIncomingEdge(it);
+                node_id_t next = graph.getSource(edge);
+                edge_weight_t distance = top.first + graph.getWeight(edge);
+                if (distance < distances[next]) {
+                    distances[next] = distance;
+                    queue.push(entry_t(distance, next));
+                }
+            }
+        } else {
+            for (edge_id_t edge = graph.getFirstOutgoing(node); edge != graph.getLastOutgoing(node); edge++) {
+                node_id_t next = graph.getTarget(edge);
+                edge_weight_t distance = top.first + graph.getWeight(edge);
+                if (distance < distances[next]) {
+                    distances[next] = distance;
+                    if (parents != nullptr) {
+                        (*parents)[next] = node;
+                    }
+                    queue.push(entry_t(distance, next));
+                }
+            }
+        }
+    }
+}
+
+}
+
+LandmarkTable::LandmarkTable() : nodeCount(0) {}
+
+LandmarkTable::LandmarkTable(const CompactFringeGraph &graph, std::size_t landmarkCount,
+                             LandmarkSelection selection, unsigned int seed) : nodeCount(graph.getNodeCount()) {
+    if (nodeCount == 0) {
+        return;
+    }
+    std::minstd_rand random(seed + 1);
+
+    for (std::size_t l = 0; l < landmarkCount && l < nodeCount; l++) {
+        node_id_t root = static_cast<node_id_t>(random() % nodeCount);
+        node_id_t landmark;
+        if (selection == LANDMARKS_AVOID && !landmarks.empty()) {
+            landmark = selectAvoid(graph, root);
+        } else {
+            landmark = selectFarthest(graph, root);
+        }
+        if (landmark == NO_LANDMARK) {
+            break;
+        }
+        addLandmark(graph, landmark);
+    }
+}
+
+edge_weight_t LandmarkTable::estimate(node_id_t from, node_id_t to) const {
+    std::size_t count = landmarks.size();
+    const edge_weight_t* fromRowFrom = fromLandmarks.data() + from * count;
+    const edge_weight_t* fromRowTo = fromLandmarks.data() + to * count;
+    const edge_weight_t* toRowFrom = toLandmarks.data() + from * count;
+    const edge_weight_t* toRowTo = toLandmarks.data() + to * count;
+
+    // Bounds involving an unreachable node say nothing, so they are skipped
+    edge_weight_t h = 0;
+    for (std::size_t l = 0; l < count; l++) {
+        if (fromRowTo[l] != UNREACHABLE && fromRowFrom[l] != UNREACHABLE) {
+            h = std::max(h, fromRowTo[l] - fromRowFrom[l]);
+        }
+        if (toRowFrom[l] != UNREACHABLE && toRowTo[l] != UNREACHABLE) {
+            h = std::max(h, toRowFrom[l] - toRowTo[l]);
+        }
+    }
+    return h;
+}
+
+void LandmarkTable::addLandmark(const CompactFringeGraph &graph, node_id_t landmark) {
+    std::vector<edge_weight_t> forward;
+    std::vector<edge_weight_t> backward;
+    shortestPaths(graph, landmark, false, forward, nullptr, nullptr);
+    shortestPaths(graph, landmark, true, backward, nullptr, nullptr);
+
+    // Insert a column into both node-major tables
+    std::size_t count = landmarks.size();
+    std::vector<edge_weight_t> newFrom(nodeCount * (count + 1));
+    std::vector<edge_weight_t> newTo(nodeCount * (count + 1));
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        std::copy(fromLandmarks.begin() + n * count, fromLandmarks.begin() + (n + 1) * count,
+                  newFrom.begin() + n * (count + 1));
+        std::copy(toLandmarks.begin() + n * count, toLandmarks.begin() + (n + 1) * count,
+                  newTo.begin() + n * (count + 1));
+        newFrom[n * (count + 1) + count] = forward[n];
+        newTo[n * (count + 1) + count] = backward[n];
+    }
+    fromLandmarks.swap(newFrom);
+    toLandmarks.swap(newTo);
+    landmarks.push_back(landmark);
+}
+
+node_id_t LandmarkTable::selectFarthest(const CompactFringeGraph &graph, node_id_t root) const {
+    // The cost to every node from its closest landmark, or from a random root if there are no landmarks yet
+    std::vector<edge_weight_t> closest;
+    if (landmarks.empty()) {
+        shortestPaths(graph, root, false, closest, nullptr, nullptr);
+    } else {
+        std::size_t count = landmarks.size();
+        closest.resize(nodeCount);
+        for (node_id_t n = 0; n < nodeCount; n++) {
+            closest[n] = *std::min_element(fromLandmarks.begin() + n * count, fromLandmarks.begin() + (n + 1) * count);
+        }
+    }
+
+    std::vector<bool> isLandmark(nodeCount, false);
+    for (node_id_t landmark : landmarks) {
+        isLandmark[landmark] = true;
+    }
+
+    // Unreachable nodes are skipped, as landmarks that reach few nodes give poor bounds. If no other node
+    // is reachable, a node no landmark reaches still gives bounds in its part of the graph, preferably the root.
+    node_id_t farthest = NO_LANDMARK;
+    edge_weight_t farthestDistance = -1;
+    node_id_t uncovered = NO_LANDMARK;
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        if (isLandmark[n]) {
+            continue;
+        }
+        if (closest[n] == UNREACHABLE) {
+            if (uncovered == NO_LANDMARK || n == root) {
+                uncovered = n;
+            }
+        } else if (closest[n] > farthestDistance) {
+            farthest = n;
+            farthestDistance = closest[n];
+        }
+    }
+    return farthest != NO_LANDMARK ? farthest : uncovered;
+}
+
+node_id_t LandmarkTable::selectAvoid(const CompactFringeGraph &graph, node_id_t root) const {
+    std::vector<edge_weight_t> distances;
+    std::vector<node_id_t> order;
+    std::vector<node_id_t> parents;
+    shortestPaths(graph, root, false, distances, &order, &parents);
+
+    // The size of a subtree is the total gap between the true costs from the root and the current bounds,
+    // subtrees containing a landmark are already covered and get size 0
+    std::vector<edge_weight_t> sizes(nodeCount, 0);
+    std::vector<bool> covered(nodeCount, false);
+    for (node_id_t landmark : landmarks) {
+        covered[landmark] = true;
+    }
+    for (node_id_t node : order) {
+        sizes[node] = distances[node] - estimate(root, node);
+    }
+
+    // Children come after their parents in order, so accumulate in reverse
+    std::vector<node_id_t> largestChild(nodeCount, root);
+    for (std::size_t i = order.size(); i > 1; i--) {
+        node_id_t node = order[i - 1];
+        node_id_t parent = parents[node];
+        if (covered[node]) {
+            covered[parent] = true;
+            sizes[node] = 0;
+        }
+        sizes[parent] += sizes[node];
+        if (largestChild[parent] == root || sizes[node] > sizes[largestChild[parent]]) {
+            largestChild[parent] = node;
+        }
+    }
+    if (covered[root]) {
+        sizes[root] = 0;
+    }
+
+    node_id_t largest = root;
+    for (node_id_t node : order) {
+        if (sizes[node] > sizes[largest]) {
+            largest = node;
+        }
+    }
+    if (sizes[largest] <= 0) {
+        // The tree is covered everywhere
+        return selectFarthest(graph, root);
+    }
+
+    // Descend to a leaf through the largest subtrees
+    node_id_t leaf = largest;
+    while (largestChild[leaf] != root && sizes[largestChild[leaf]] > 0) {
+        leaf = largestChild[leaf];
+    }
+    return leaf;
+}
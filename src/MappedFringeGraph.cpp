@@ -0,0 +1,220 @@
+#include "MappedFringeGraph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[4] = {'F', 'S', 'G', 'R'};
+const uint32_t FORMAT_VERSION = 1;
+
+// Written in the byte order of the writer, so files from a machine with a different byte order are rejected
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Every array starts at a multiple of this, so it is aligned for its type and to cache lines
+const uint64_t SECTION_ALIGNMENT = 64;
+
+const uint32_t FLAG_COORDINATES = 1;
+
+enum Section {
+    OFFSETS, TARGETS, WEIGHTS, SOURCES, INCOMING_OFFSETS, INCOMING_EDGES, X, Y, SECTION_COUNT
+};
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t flags;
+    uint32_t nodeCount;
+    uint32_t reserved;
+    uint64_t edgeCount;
+
+    // The position of every array from the start of the file, 0 if the array is absent
+    uint64_t sections[SECTION_COUNT];
+};
+
+// The position of the next section after the given position in the file
+uint64_t getSectionPosition(uint64_t position) {
+    return (position + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// Write an array at the next section position, padding with zeros up to it
+template <class T>
+void writeSection(std::ostream& out, uint64_t& position, const std::vector<T>& values) {
+    static const char padding[SECTION_ALIGNMENT] = {};
+    uint64_t aligned = getSectionPosition(position);
+    out.write(padding, aligned - position);
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    position = aligned + values.size() * sizeof(T);
+}
+
+// Find an array of count values in the mapped file, nullptr if it does not fit
+template <class T>
+const T* getSection(const void* mapping, std::size_t size, uint64_t position, uint64_t count) {
+    if (position == 0 || position % SECTION_ALIGNMENT != 0 || position > size
+        || count > (size - position) / sizeof(T)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(static_cast<const char*>(mapping) + position);
+}
+
+}
+
+MappedFringeGraph::MappedFringeGraph() : mapping(nullptr), mappingSize(0) {
+    close();
+}
+
+MappedFringeGraph::~MappedFringeGraph() {
+    close();
+}
+
+bool MappedFringeGraph::save(std::ostream &out, const CompactFringeGraph &graph, const NodeCoordinates *coordinates) {
+    node_id_t nodeCount = graph.getNodeCount();
+    edge_id_t edgeCount = graph.getEdgeCount();
+    if (coordinates != nullptr && (coordinates->x.size() != nodeCount || coordinates->y.size() != nodeCount)) {
+        return false;
+    }
+
+    // Collect the arrays through the graph interface
+    std::vector<edge_id_t> offsets(nodeCount + 1, edgeCount);
+    std::vector<edge_id_t> incomingOffsets(nodeCount + 1, edgeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        offsets[n] = graph.getFirstOutgoing(n);
+        incomingOffsets[n] = static_cast<edge_id_t>(graph.getFirstIncoming(n) - graph.getFirstIncoming(0));
+    }
+    std::vector<node_id_t> targets(edgeCount);
+    std::vector<edge_weight_t> weights(edgeCount);
+    std::vector<node_id_t> sources(edgeCount);
+    for (edge_id_t e = 0; e < edgeCount; e++) {
+        targets[e] = graph.getTarget(e);
+        weights[e] = graph.getWeight(e);
+        sources[e] = graph.getSource(e);
+    }
+    std::vector<edge_id_t> incomingEdges(graph.getFirstIncoming(0), graph.getFirstIncoming(0) + edgeCount);
+
+    FileHeader header = {};
+    std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.magic);
+    header.version = FORMAT_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.flags = coordinates != nullptr ? FLAG_COORDINATES : 0;
+    header.nodeCount = nodeCount;
+    header.edgeCount = edgeCount;
+
+    // Lay out the sections in order, so the writes below only need to pad up to each of them
+    uint64_t sizes[SECTION_COUNT] = {
+            offsets.size() * sizeof(edge_id_t), targets.size() * sizeof(node_id_t),
+            weights.size() * sizeof(edge_weight_t), sources.size() * sizeof(node_id_t),
+            incomingOffsets.size() * sizeof(edge_id_t), incomingEdges.size() * sizeof(edge_id_t),
+            nodeCount * sizeof(edge_weight_t), nodeCount * sizeof(edge_weight_t)
+    };
+    int sectionCount = coordinates != nullptr ? SECTION_COUNT : X;
+    uint64_t position = sizeof(FileHeader);
+    for (int s = 0; s < sectionCount; s++) {
+        header.sections[s] = getSectionPosition(position);
+        position = header.sections[s] + sizes[s];
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position = sizeof(FileHeader);
+    writeSection(out, position, offsets);
+    writeSection(out, position, targets);
+    writeSection(out, position, weights);
+    writeSection(out, position, sources);
+    writeSection(out, position, incomingOffsets);
+    writeSection(out, position, incomingEdges);
+    if (coordinates != nullptr) {
+        writeSection(out, position, coordinates->x);
+        writeSection(out, position, coordinates->y);
+    }
+    return static_cast<bool>(out);
+}
+
+bool MappedFringeGraph::open(const std::string &path) {
+    close();
+
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        ::close(file);
+        return false;
+    }
+
+    // Shared read-only pages, so all processes mapping the file use the same copy in the page cache
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* result = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (result == MAP_FAILED) {
+        return false;
+    }
+    mapping = result;
+    mappingSize = size;
+
+    // Only the header and the bounds of the arrays are checked, so opening takes constant time
+    const FileHeader& header = *static_cast<const FileHeader*>(mapping);
+    if (!std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.magic) || header.version != FORMAT_VERSION
+        || header.byteOrderMark != BYTE_ORDER_MARK || header.edgeCount > std::numeric_limits<edge_id_t>::max()) {
+        close();
+        return false;
+    }
+
+    uint64_t nodes = header.nodeCount;
+    uint64_t edges = header.edgeCount;
+    offsets = getSection<edge_id_t>(mapping, size, header.sections[OFFSETS], nodes + 1);
+    targets = getSection<node_id_t>(mapping, size, header.sections[TARGETS], edges);
+    weights = getSection<edge_weight_t>(mapping, size, header.sections[WEIGHTS], edges);
+    sources = getSection<node_id_t>(mapping, size, header.sections[SOURCES], edges);
+    incomingOffsets = getSection<edge_id_t>(mapping, size, header.sections[INCOMING_OFFSETS], nodes + 1);
+    incomingEdges = getSection<edge_id_t>(mapping, size, header.sections[INCOMING_EDGES], edges);
+    if (header.flags & FLAG_COORDINATES) {
+        x = getSection<edge_weight_t>(mapping, size, header.sections[X], nodes);
+        y = getSection<edge_weight_t>(mapping, size, header.sections[Y], nodes);
+    }
+    if (offsets == nullptr || targets == nullptr || weights == nullptr || sources == nullptr
+        || incomingOffsets == nullptr || incomingEdges == nullptr
+        || ((header.flags & FLAG_COORDINATES) && (x == nullptr || y == nullptr))
+        || offsets[0] != 0 || offsets[nodes] != edges || incomingOffsets[0] != 0 || incomingOffsets[nodes] != edges) {
+        close();
+        return false;
+    }
+
+    nodeCount = header.nodeCount;
+    edgeCount = static_cast<edge_id_t>(header.edgeCount);
+    return true;
+}
+
+void MappedFringeGraph::close() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    nodeCount = 0;
+    edgeCount = 0;
+    offsets = nullptr;
+    targets = nullptr;
+    weights = nullptr;
+    sources = nullptr;
+    incomingOffsets = nullptr;
+    incomingEdges = nullptr;
+    x = nullptr;
+    y = nullptr;
+}
+
+bool MappedFringeGraph::getCoordinates(NodeCoordinates &coordinates) const {
+    if (!hasCoordinates()) {
+        return false;
+    }
+    coordinates.x.assign(x, x + nodeCount);
+    coordinates.y.assign(y, y + nodeCount);
+    return true;
+}
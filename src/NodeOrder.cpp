@@ -0,0 +1,200 @@
+#include "NodeOrder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+// The number of cells per side of the grid the Hilbert curve passes through
+const uint32_t HILBERT_SIDE = 1u << 16;
+
+// The maximum number of searches for a node far from the others in a component
+const unsigned int MAX_PERIPHERAL_SEARCHES = 8;
+
+// Call function(neighbour) for the targets of outgoing and the sources of incoming edges of a node
+template <class Function>
+void forEachNeighbour(const CompactFringeGraph& graph, node_id_t node, const Function& function) {
+    for (edge_id_t e = graph.getFirstOutgoing(node); e != graph.getLastOutgoing(node); e++) {
+        function(graph.getTarget(e));
+    }
+    for (const edge_id_t* it = graph.getFirstIncoming(node); it != graph.getLastIncoming(node); ++it) {
+        function(graph.getSource(*it));
+    }
+}
+
+/*
+ * Append the nodes reached by a breadth-first search from root to order, in the
+ * order they are reached. Nodes already marked as visited are not searched. If
+ * degrees are given, the neighbours of every node are appended in order of
+ * increasing degree.
+ */
+void appendBreadthFirst(const CompactFringeGraph& graph, node_id_t root, const std::vector<node_id_t>* degrees,
+                        std::vector<char>& visited, std::vector<node_id_t>& order) {
+    std::size_t begin = order.size();
+    visited[root] = 1;
+    order.push_back(root);
+    for (std::size_t i = begin; i < order.size(); i++) {
+        std::size_t first = order.size();
+        forEachNeighbour(graph, order[i], [&](node_id_t neighbour) {
+            if (!visited[neighbour]) {
+                visited[neighbour] = 1;
+                order.push_back(neighbour);
+            }
+        });
+        if (degrees != nullptr) {
+            std::sort(order.begin() + first, order.end(), [&](node_id_t a, node_id_t b) {
+                return (*degrees)[a] < (*degrees)[b] || ((*degrees)[a] == (*degrees)[b] && a < b);
+            });
+        }
+    }
+}
+
+/*
+ * Find a node with a high eccentricity in the component of start, by repeatedly
+ * searching from the lowest-degree node of the last level of the previous search
+ * until the number of levels stops growing.
+ */
+node_id_t findPeripheralNode(const CompactFringeGraph& graph, node_id_t start, const std::vector<node_id_t>& degrees,
+                             std::vector<uint32_t>& levels, std::vector<node_id_t>& queue) {
+    static const uint32_t UNREACHED = std::numeric_limits<uint32_t>::max();
+
+    node_id_t root = start;
+    uint32_t eccentricity = 0;
+    for (unsigned int s = 0; s < MAX_PERIPHERAL_SEARCHES; s++) {
+        queue.clear();
+        queue.push_back(root);
+        levels[root] = 0;
+        for (std::size_t i = 0; i < queue.size(); i++) {
+            uint32_t level = levels[queue[i]] + 1;
+            forEachNeighbour(graph, queue[i], [&](node_id_t neighbour) {
+                if (levels[neighbour] == UNREACHED) {
+                    levels[neighbour] = level;
+                    queue.push_back(neighbour);
+                }
+            });
+        }
+
+        // Reset the levels of the component for the next search
+        uint32_t lastLevel = levels[queue.back()];
+        node_id_t candidate = queue.back();
+        for (node_id_t node : queue) {
+            if (levels[node] == lastLevel && degrees[node] < degrees[candidate]) {
+                candidate = node;
+            }
+            levels[node] = UNREACHED;
+        }
+
+        if (lastLevel <= eccentricity) {
+            break;
+        }
+        eccentricity = lastLevel;
+        root = candidate;
+    }
+    return root;
+}
+
+// The position of a cell along the Hilbert curve through the grid
+uint64_t getHilbertIndex(uint32_t x, uint32_t y) {
+    uint64_t index = 0;
+    for (uint32_t s = HILBERT_SIDE / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) != 0;
+        uint32_t ry = (y & s) != 0;
+        index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant so the curve continues from the previous one
+        if (ry == 0) {
+            if (rx == 1) {
+                x = HILBERT_SIDE - 1 - x;
+                y = HILBERT_SIDE - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+}
+
+NodeOrder::NodeOrder() {}
+
+NodeOrder::NodeOrder(const std::vector<node_id_t> &order) : originalIndices(order), reorderedIndices(order.size()) {
+    for (node_id_t n = 0; n < order.size(); n++) {
+        reorderedIndices[order[n]] = n;
+    }
+}
+
+NodeOrder NodeOrder::breadthFirst(const CompactFringeGraph &graph) {
+    node_id_t nodeCount = graph.getNodeCount();
+    std::vector<char> visited(nodeCount, 0);
+    std::vector<node_id_t> order;
+    order.reserve(nodeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        if (!visited[n]) {
+            appendBreadthFirst(graph, n, nullptr, visited, order);
+        }
+    }
+    return NodeOrder(order);
+}
+
+NodeOrder NodeOrder::reverseCuthillMcKee(const CompactFringeGraph &graph) {
+    node_id_t nodeCount = graph.getNodeCount();
+    std::vector<node_id_t> degrees(nodeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        degrees[n] = (graph.getLastOutgoing(n) - graph.getFirstOutgoing(n))
+                     + static_cast<node_id_t>(graph.getLastIncoming(n) - graph.getFirstIncoming(n));
+    }
+
+    std::vector<char> visited(nodeCount, 0);
+    std::vector<uint32_t> levels(nodeCount, std::numeric_limits<uint32_t>::max());
+    std::vector<node_id_t> queue;
+    std::vector<node_id_t> order;
+    order.reserve(nodeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        if (!visited[n]) {
+            node_id_t root = findPeripheralNode(graph, n, degrees, levels, queue);
+            appendBreadthFirst(graph, root, &degrees, visited, order);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return NodeOrder(order);
+}
+
+NodeOrder NodeOrder::hilbertCurve(const NodeCoordinates &coordinates) {
+    node_id_t nodeCount = static_cast<node_id_t>(coordinates.x.size());
+    if (nodeCount == 0) {
+        return NodeOrder();
+    }
+
+    // Scale both axes by the same factor, so the curve's neighbourhoods stay square
+    auto xRange = std::minmax_element(coordinates.x.begin(), coordinates.x.end());
+    auto yRange = std::minmax_element(coordinates.y.begin(), coordinates.y.end());
+    double extent = std::max(*xRange.second - *xRange.first, *yRange.second - *yRange.first);
+    double scale = extent > 0 ? (HILBERT_SIDE - 1) / extent : 0;
+
+    std::vector<std::pair<uint64_t, node_id_t>> keys(nodeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        uint32_t x = static_cast<uint32_t>((coordinates.x[n] - *xRange.first) * scale);
+        uint32_t y = static_cast<uint32_t>((coordinates.y[n] - *yRange.first) * scale);
+        keys[n] = std::make_pair(getHilbertIndex(std::min(x, HILBERT_SIDE - 1), std::min(y, HILBERT_SIDE - 1)), n);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<node_id_t> order(nodeCount);
+    for (node_id_t n = 0; n < nodeCount; n++) {
+        order[n] = keys[n].second;
+    }
+    return NodeOrder(order);
+}
+
+NodeCoordinates NodeOrder::apply(const NodeCoordinates &coordinates) const {
+    NodeCoordinates result;
+    result.x.reserve(originalIndices.size());
+    result.y.reserve(originalIndices.size());
+    for (node_id_t node : originalIndices) {
+        result.x.push_back(coordinates.x[node]);
+        result.y.push_back(coordinates.y[node]);
+    }
+    return result;
+}
@@ -3,6 +3,22 @@
 
 #include "FringeGraph.h"
 #include "FringeSearch.h"
+#include "CompactFringeGraph.h"
+#include "CompactFringeSearch.h"
+#include "PointerFringeGraph.h"
+#include "BidirectionalFringeSearch.h"
+#include "DistanceMatrix.h"
+#include "GraphBuilder.h"
+#include "GeometricHeuristics.h"
+#include "LandmarkHeuristic.h"
+#include "ContractionHierarchy.h"
+#include "GridFringeGraph.h"
+#include "IncrementalSearch.h"
+#include "AnytimeFringeSearch.h"
+#include "JumpPointGraph.h"
+#include "MappedFringeGraph.h"
+#include "GraphImporter.h"
+#include "NodeOrder.h"
 
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
@@ -11,7 +27,15 @@
 #include <boost/random/linear_congruential.hpp>
 #include <boost/random/random_device.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath> 
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 // Number of graphs to compare shortest paths on
 static const unsigned int NUM_TEST_GRAPHS = 1000;
@@ -24,20 +48,82 @@ typedef boost::adjacency_list< boost::listS, boost::vecS, boost::directedS, boos
 typedef boost::erdos_renyi_iterator<boost::minstd_rand, graph_t> er_generator_t;
 typedef boost::graph_traits < graph_t >::vertex_descriptor vertex_descriptor;
 
+/**
+ * Generate an Erdos-Renyi graph with random edge weights.
+ */
+static graph_t generateGraph(boost::minstd_rand& gen) {
+    graph_t g(er_generator_t(gen, NODES_PER_TEST_GRAPH, ER_PARAMETER), er_generator_t(), NODES_PER_TEST_GRAPH);
+
+    // Set random weights
+    auto unweightedEdges = boost::edges(g);
+    for (auto eit = unweightedEdges.first; eit != unweightedEdges.second; eit++) {
+        float weight = 10.0f * (gen() - gen.min()) / (gen.max() - gen.min());
+        boost::put(boost::edge_weight_t(), g, *eit, weight);
+    }
+    return g;
+}
+
+/**
+ * Generate a 4-connected grid graph with random edge weights in both directions.
+ */
+static graph_t generateGridGraph(boost::minstd_rand& gen, unsigned int width, unsigned int height) {
+    graph_t g(width * height);
+    for (unsigned int y = 0; y < height; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            unsigned int n = y * width + x;
+            std::vector<unsigned int> neighbours;
+            if (x + 1 < width) {
+                neighbours.push_back(n + 1);
+            }
+            if (y + 1 < height) {
+                neighbours.push_back(n + width);
+            }
+            for (unsigned int m : neighbours) {
+                boost::add_edge(n, m, 1.0f + 10.0f * (gen() - gen.min()) / (gen.max() - gen.min()), g);
+                boost::add_edge(m, n, 1.0f + 10.0f * (gen() - gen.min()) / (gen.max() - gen.min()), g);
+            }
+        }
+    }
+    return g;
+}
+
+/**
+ * Convert a boost graph to a graph of fringe nodes and edges.
+ */
+static std::vector<FringeNode<void>*> toFringeNodes(const graph_t& g) {
+    std::vector<FringeNode<void>*> fringeNodes;
+    for (unsigned int n = 0; n < num_vertices(g); n++) {
+        fringeNodes.push_back(new FringeNode<void>(n));
+    }
+    auto edges = boost::edges(g);
+    edge_id_t currentId = 0;
+    for (auto eit = edges.first; eit != edges.second; eit++) {
+        float weight = boost::get(boost::edge_weight_t(), g, *eit);
+        new FringeEdge<void>(currentId++, fringeNodes[(*eit).m_source], fringeNodes[(*eit).m_target], weight);
+    }
+    return fringeNodes;
+}
+
+/**
+ * Convert a boost graph to a raw edge list.
+ */
+static std::vector<CompactFringeEdge> toEdgeList(const graph_t& g) {
+    std::vector<CompactFringeEdge> result;
+    auto edges = boost::edges(g);
+    for (auto eit = edges.first; eit != edges.second; eit++) {
+        float weight = boost::get(boost::edge_weight_t(), g, *eit);
+        result.push_back({static_cast<node_id_t>((*eit).m_source), static_cast<node_id_t>((*eit).m_target), weight});
+    }
+    return result;
+}
+
 TEST_CASE("Fringe search returns the same paths as Boost's Dijkstra implementation on random graphs") {
 
     boost::random_device rd;
     boost::minstd_rand gen(rd);
     SECTION("Generate a random graph and compare paths") {
         for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
-            graph_t g(er_generator_t(gen, NODES_PER_TEST_GRAPH, ER_PARAMETER), er_generator_t(), NODES_PER_TEST_GRAPH);
-
-            // Set random weights
-            auto unweightedEdges = boost::edges(g);
-            for (auto eit = unweightedEdges.first; eit != unweightedEdges.second; eit++) {
-                float weight = 10.0f * (gen() - gen.min()) / (gen.max() - gen.min());
-                boost::put(boost::edge_weight_t(), g, *eit, weight);
-            }
+            graph_t g = generateGraph(gen);
 
             std::vector<vertex_descriptor> predecessors(num_vertices(g));
             std::vector<float> distances(num_vertices(g));
@@ -91,3 +177,1223 @@ TEST_CASE("Fringe search returns the same paths as Boost's Dijkstra implementati
         }
     }
 }
+
+TEST_CASE("Fringe search on a compact graph returns the same costs as Boost's Dijkstra implementation") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        CompactFringeGraph compactGraph(NODES_PER_TEST_GRAPH, toEdgeList(g));
+        CompactFringeSearch search(compactGraph);
+        search.reset(0);
+
+        node_id_t target = NODES_PER_TEST_GRAPH - 1;
+        std::vector<node_id_t>* fringePath = search.search(target);
+
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE(fringePath == nullptr);
+        } else {
+            REQUIRE(fringePath != nullptr);
+            REQUIRE(std::abs(distances[target] - search.cost(target)) < 1E-4);
+            REQUIRE(fringePath->front() == target);
+            delete fringePath;
+        }
+
+        // Searching into a reused buffer should give the same path in forward order
+        PathBuffer<CompactFringeGraph> pathBuffer;
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE_FALSE(search.search(target, pathBuffer));
+            REQUIRE(search.searchCost(target) == std::numeric_limits<float>::infinity());
+        } else {
+            REQUIRE(search.search(target, pathBuffer));
+            REQUIRE(pathBuffer.nodes.front() == 0);
+            REQUIRE(pathBuffer.nodes.back() == target);
+            REQUIRE(std::abs(distances[target] - search.searchCost(target)) < 1E-4);
+
+            // The edges should connect the nodes and add up to the cost
+            REQUIRE(pathBuffer.edges.size() + 1 == pathBuffer.nodes.size());
+            float pathCost = 0;
+            for (std::size_t e = 0; e < pathBuffer.edges.size(); e++) {
+                REQUIRE(compactGraph.getSource(pathBuffer.edges[e]) == pathBuffer.nodes[e]);
+                REQUIRE(compactGraph.getTarget(pathBuffer.edges[e]) == pathBuffer.nodes[e + 1]);
+                pathCost += compactGraph.getWeight(pathBuffer.edges[e]);
+            }
+            REQUIRE(std::abs(distances[target] - pathCost) < 1E-4);
+
+            std::vector<node_id_t> buffer(pathBuffer.nodes.size());
+            REQUIRE(search.search(target, buffer.data(), buffer.size()) == buffer.size());
+            REQUIRE(buffer == pathBuffer.nodes);
+        }
+
+        // The split fringe should find paths of the same cost
+        FringeSearchT<CompactFringeGraph, ZeroHeuristic, DefaultWeight, SplitFringe> splitSearch(compactGraph);
+        splitSearch.reset(0);
+        std::vector<node_id_t>* splitPath = splitSearch.search(target);
+
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE(splitPath == nullptr);
+        } else {
+            REQUIRE(splitPath != nullptr);
+            REQUIRE(std::abs(distances[target] - splitSearch.cost(target)) < 1E-4);
+            delete splitPath;
+        }
+
+        // So should the columnar context, which keeps every search field in its own array
+        FringeSearchT<CompactFringeGraph, ZeroHeuristic, DefaultWeight, SplitFringe, ColumnarSearchContext>
+                columnarSearch(compactGraph);
+        columnarSearch.reset(0);
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE_FALSE(columnarSearch.search(target, pathBuffer));
+        } else {
+            REQUIRE(columnarSearch.search(target, pathBuffer));
+            REQUIRE(std::abs(distances[target] - columnarSearch.cost(target)) < 1E-4);
+            REQUIRE(pathBuffer.nodes.back() == target);
+        }
+    }
+}
+
+TEST_CASE("Concurrent fringe searches on one graph return the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int NUM_THREADS = 4;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    graph_t g = generateGraph(gen);
+
+    std::vector<float> distances(num_vertices(g));
+    vertex_descriptor source(boost::vertex(0, g));
+    boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+    std::vector<FringeNode<void>*> fringeNodes = toFringeNodes(g);
+
+    // Every thread searches a disjoint set of targets using its own context
+    std::vector<float> costs(NODES_PER_TEST_GRAPH, std::numeric_limits<float>::max());
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&fringeNodes, &costs, t]() {
+            SearchContext context(NODES_PER_TEST_GRAPH);
+            FringeSearch search(context);
+            for (unsigned int target = t; target < NODES_PER_TEST_GRAPH; target += NUM_THREADS) {
+                search.reset(fringeNodes[0]);
+                std::vector<BaseFringeNode*>* path = search.search(fringeNodes[target]);
+                if (path != nullptr) {
+                    costs[target] = search.cost(fringeNodes[target]);
+                    delete path;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (unsigned int target = 0; target < NODES_PER_TEST_GRAPH; target++) {
+        REQUIRE(std::abs(distances[target] - costs[target]) < 1E-4);
+    }
+}
+
+TEST_CASE("Fringe search only reports the targets it reached") {
+    // Node 1 is first discovered directly at cost 10, the search for node 2 stops before finding its cost of 2
+    std::vector<CompactFringeEdge> edges = {{0, 1, 10}, {0, 2, 1}, {2, 1, 1}};
+    CompactFringeGraph graph(3, edges);
+    CompactFringeSearch search(graph);
+    PathBuffer<CompactFringeGraph> path;
+
+    search.reset(0);
+    REQUIRE(search.searchCost(2) == 1);
+    REQUIRE(search.reached(2));
+    REQUIRE_FALSE(search.reached(1));
+    REQUIRE(search.cost(1) == std::numeric_limits<edge_weight_t>::infinity());
+    REQUIRE(search.path(1) == nullptr);
+    REQUIRE_FALSE(search.path(1, path));
+
+    REQUIRE(search.search(std::vector<node_id_t>(1, 2)) == 1);
+    REQUIRE_FALSE(search.reached(1));
+    REQUIRE(search.cost(1) == std::numeric_limits<edge_weight_t>::infinity());
+
+    // Searching for both finds the best path to node 1
+    REQUIRE(search.search(std::vector<node_id_t>{1, 2}) == 2);
+    REQUIRE(search.cost(1) == 2);
+    REQUIRE(search.cost(2) == 1);
+}
+
+TEST_CASE("Policy-based fringe search on a pointer graph returns the same costs as Boost's Dijkstra implementation") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        std::vector<FringeNode<void>*> fringeNodes = toFringeNodes(g);
+        PointerFringeGraph pointerGraph;
+        FringeSearchT<PointerFringeGraph, DataHeuristic<void>, DataWeight<void>> search(pointerGraph);
+        search.reset(fringeNodes[0]);
+
+        FringeNode<void>* target = fringeNodes[NODES_PER_TEST_GRAPH - 1];
+        std::vector<BaseFringeNode*>* fringePath = search.search(target);
+
+        if (distances[NODES_PER_TEST_GRAPH - 1] == std::numeric_limits<float>::max()) {
+            REQUIRE(fringePath == nullptr);
+        } else {
+            REQUIRE(fringePath != nullptr);
+            REQUIRE(std::abs(distances[NODES_PER_TEST_GRAPH - 1] - search.cost(target)) < 1E-4);
+            delete fringePath;
+        }
+    }
+}
+
+TEST_CASE("Bidirectional fringe search returns the same costs as Boost's Dijkstra implementation") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        CompactFringeGraph compactGraph(NODES_PER_TEST_GRAPH, toEdgeList(g));
+        BidirectionalFringeSearchT<CompactFringeGraph> search(compactGraph);
+        search.reset(0);
+
+        // The cost of a previous query must not be reported for a later one
+        delete search.search(0);
+        REQUIRE(search.cost(0) == 0);
+
+        node_id_t target = NODES_PER_TEST_GRAPH - 1;
+        std::vector<node_id_t>* fringePath = search.search(target);
+        REQUIRE(search.cost(0) == std::numeric_limits<edge_weight_t>::infinity());
+
+        PathBuffer<CompactFringeGraph> path;
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE(fringePath == nullptr);
+            REQUIRE(search.cost(target) == std::numeric_limits<edge_weight_t>::infinity());
+            REQUIRE_FALSE(search.path(path));
+            REQUIRE(path.nodes.empty());
+        } else {
+            REQUIRE(fringePath != nullptr);
+            REQUIRE(std::abs(distances[target] - search.cost(target)) < 1E-4);
+
+            // The path should be connected and cost as much as reported
+            float pathCost = 0;
+            node_id_t next = target;
+            for (std::size_t n = 1; n <= fringePath->size(); n++) {
+                node_id_t previous = n < fringePath->size() ? (*fringePath)[n] : 0;
+                REQUIRE((*fringePath)[n - 1] == next);
+                float edgeWeight = std::numeric_limits<float>::max();
+                for (edge_id_t e = compactGraph.getFirstOutgoing(previous); e < compactGraph.getLastOutgoing(previous); e++) {
+                    if (compactGraph.getTarget(e) == next && compactGraph.getWeight(e) < edgeWeight) {
+                        edgeWeight = compactGraph.getWeight(e);
+                    }
+                }
+                REQUIRE(edgeWeight < std::numeric_limits<float>::max());
+                pathCost += edgeWeight;
+                next = previous;
+            }
+            REQUIRE(std::abs(distances[target] - pathCost) < 1E-4);
+            delete fringePath;
+
+            // The buffered path lists the edges between its nodes
+            REQUIRE(search.path(path));
+            REQUIRE(path.nodes.front() == 0);
+            REQUIRE(path.nodes.back() == target);
+            REQUIRE(path.edges.size() + 1 == path.nodes.size());
+            pathCost = 0;
+            for (std::size_t e = 0; e < path.edges.size(); e++) {
+                REQUIRE(compactGraph.getSource(path.edges[e]) == path.nodes[e]);
+                REQUIRE(compactGraph.getTarget(path.edges[e]) == path.nodes[e + 1]);
+                pathCost += compactGraph.getWeight(path.edges[e]);
+            }
+            REQUIRE(std::abs(distances[target] - pathCost) < 1E-4);
+
+            search.reset(0);
+            REQUIRE(search.search(target, path));
+            REQUIRE(path.nodes.back() == target);
+        }
+    }
+}
+
+TEST_CASE("One-to-many fringe search returns the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int NUM_TARGETS = 20;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        std::vector<FringeNode<void>*> fringeNodes = toFringeNodes(g);
+        std::vector<BaseFringeNode*> targets;
+        unsigned int reachable = 0;
+        for (unsigned int t = 0; t < NUM_TARGETS; t++) {
+            unsigned int target = gen() % NODES_PER_TEST_GRAPH;
+            if (std::find(targets.begin(), targets.end(), fringeNodes[target]) != targets.end()) {
+                continue;
+            }
+            targets.push_back(fringeNodes[target]);
+            if (distances[target] != std::numeric_limits<float>::max()) {
+                reachable++;
+            }
+        }
+
+        FringeSearch search(fringeNodes[0]);
+        REQUIRE(search.search(targets) == reachable);
+
+        for (BaseFringeNode* target : targets) {
+            std::vector<BaseFringeNode*>* fringePath = search.path(target);
+            if (distances[target->getID()] == std::numeric_limits<float>::max()) {
+                REQUIRE(fringePath == nullptr);
+            } else {
+                REQUIRE(fringePath != nullptr);
+                REQUIRE(std::abs(distances[target->getID()] - search.cost(target)) < 1E-4);
+                delete fringePath;
+            }
+        }
+    }
+}
+
+TEST_CASE("Distance matrices contain the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int NUM_MATRIX_GRAPHS = 20;
+    static const unsigned int NUM_SOURCES = 10;
+    static const unsigned int NUM_TARGETS = 50;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_MATRIX_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+        CompactFringeGraph compactGraph(NODES_PER_TEST_GRAPH, toEdgeList(g));
+
+        std::vector<node_id_t> sources;
+        for (unsigned int s = 0; s < NUM_SOURCES; s++) {
+            sources.push_back(gen() % NODES_PER_TEST_GRAPH);
+        }
+        std::vector<node_id_t> targets;
+        for (unsigned int t = 0; t < NUM_TARGETS; t++) {
+            targets.push_back(gen() % NODES_PER_TEST_GRAPH);
+        }
+
+        std::vector<float> matrix(NUM_SOURCES * NUM_TARGETS);
+        DistanceMatrixT<CompactFringeGraph> distanceMatrix(compactGraph, 4);
+        distanceMatrix.compute(sources, targets, matrix.data());
+
+        for (unsigned int s = 0; s < NUM_SOURCES; s++) {
+            std::vector<float> distances(num_vertices(g));
+            boost::dijkstra_shortest_paths(g, boost::vertex(sources[s], g), boost::distance_map(&distances[0]));
+
+            for (unsigned int t = 0; t < NUM_TARGETS; t++) {
+                float cost = matrix[s * NUM_TARGETS + t];
+                if (distances[targets[t]] == std::numeric_limits<float>::max()) {
+                    REQUIRE(cost == std::numeric_limits<float>::infinity());
+                } else {
+                    REQUIRE(std::abs(distances[targets[t]] - cost) < 1E-4);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Heuristic that throws on every thread but the one that created it, which is slowed down instead.
+ */
+struct OtherThreadThrowingHeuristic {
+    std::thread::id owner = std::this_thread::get_id();
+
+    edge_weight_t operator()(const CompactFringeGraph& graph, node_id_t from, node_id_t to) const {
+        if (std::this_thread::get_id() != owner) {
+            throw std::runtime_error("heuristic failed");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return 0;
+    }
+};
+
+TEST_CASE("Distance matrix rethrows exceptions of its worker threads") {
+    static const unsigned int NUM_SOURCES = 100;
+
+    std::vector<CompactFringeEdge> chain = {{0, 1, 1}, {1, 2, 1}};
+    CompactFringeGraph chainGraph(3, chain);
+    std::vector<node_id_t> sources(NUM_SOURCES, 0);
+    std::vector<node_id_t> targets(1, 2);
+    std::vector<float> matrix(NUM_SOURCES);
+
+    // The calling thread is slow enough to leave sources to the workers
+    DistanceMatrixT<CompactFringeGraph, OtherThreadThrowingHeuristic> distanceMatrix(chainGraph, 4);
+    REQUIRE_THROWS_AS(distanceMatrix.compute(sources, targets, matrix.data()), std::runtime_error);
+
+    // Computing on the calling thread alone does not throw
+    DistanceMatrixT<CompactFringeGraph, OtherThreadThrowingHeuristic> singleThreaded(chainGraph, 1);
+    singleThreaded.compute(sources, targets, matrix.data());
+    REQUIRE(matrix[NUM_SOURCES - 1] == 2);
+}
+
+TEST_CASE("Fringe search on an arena-allocated graph returns the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int NUM_ARENA_GRAPHS = 100;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_ARENA_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        // Use small blocks so the arena has to allocate several
+        FringeGraph fringeGraph(1 << 12);
+        for (unsigned int n = 0; n < NODES_PER_TEST_GRAPH; n++) {
+            fringeGraph.addNode(n);
+        }
+        const std::vector<BaseFringeNode*>& nodes = fringeGraph.getNodes();
+        auto edges = boost::edges(g);
+        for (auto eit = edges.first; eit != edges.second; eit++) {
+            float weight = boost::get(boost::edge_weight_t(), g, *eit);
+            fringeGraph.addEdge(nodes[(*eit).m_source], nodes[(*eit).m_target], weight);
+        }
+        REQUIRE(fringeGraph.getEdgeCount() == num_edges(g));
+
+        FringeSearch search(nodes[0]);
+        BaseFringeNode* target = nodes[NODES_PER_TEST_GRAPH - 1];
+        if (distances[NODES_PER_TEST_GRAPH - 1] == std::numeric_limits<float>::max()) {
+            REQUIRE(search.searchCost(target) == std::numeric_limits<edge_weight_t>::infinity());
+        } else {
+            REQUIRE(std::abs(distances[NODES_PER_TEST_GRAPH - 1] - search.searchCost(target)) < 1E-4);
+        }
+    }
+}
+
+TEST_CASE("Fringe search on a bulk-built graph returns the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int NUM_BUILT_GRAPHS = 100;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_BUILT_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        FringeGraph fringeGraph;
+        GraphBuilder builder(NODES_PER_TEST_GRAPH, toEdgeList(g));
+        builder.build(fringeGraph);
+        REQUIRE(fringeGraph.getNodeCount() == NODES_PER_TEST_GRAPH);
+        REQUIRE(fringeGraph.getEdgeCount() == num_edges(g));
+
+        // Adjacency lists were allocated once with their final size
+        for (node_id_t n = 0; n < NODES_PER_TEST_GRAPH; n++) {
+            BaseFringeNode* node = fringeGraph.getNode(n);
+            REQUIRE(node->getID() == n);
+            REQUIRE(node->getOutgoing().capacity() == node->getOutgoing().size());
+            REQUIRE(node->getIncoming().capacity() == node->getIncoming().size());
+        }
+        REQUIRE(fringeGraph.getNode(NODES_PER_TEST_GRAPH) == nullptr);
+
+        FringeSearch search(fringeGraph.getNode(0));
+        BaseFringeNode* target = fringeGraph.getNode(NODES_PER_TEST_GRAPH - 1);
+        if (distances[NODES_PER_TEST_GRAPH - 1] == std::numeric_limits<float>::max()) {
+            REQUIRE(search.searchCost(target) == std::numeric_limits<edge_weight_t>::infinity());
+        } else {
+            REQUIRE(std::abs(distances[NODES_PER_TEST_GRAPH - 1] - search.searchCost(target)) < 1E-4);
+        }
+    }
+}
+
+TEST_CASE("Fringe search with a Euclidean heuristic returns the same costs as Boost's Dijkstra implementation") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        graph_t g(er_generator_t(gen, NODES_PER_TEST_GRAPH, ER_PARAMETER), er_generator_t(), NODES_PER_TEST_GRAPH);
+
+        // Place nodes randomly in the unit square, and make edges at least as long as the distance between them
+        NodeCoordinates coordinates;
+        for (unsigned int n = 0; n < NODES_PER_TEST_GRAPH; n++) {
+            coordinates.x.push_back(static_cast<float>(gen() - gen.min()) / (gen.max() - gen.min()));
+            coordinates.y.push_back(static_cast<float>(gen() - gen.min()) / (gen.max() - gen.min()));
+        }
+        EuclideanHeuristic heuristic(coordinates);
+        auto unweightedEdges = boost::edges(g);
+        for (auto eit = unweightedEdges.first; eit != unweightedEdges.second; eit++) {
+            float detour = 1.0f + static_cast<float>(gen() - gen.min()) / (gen.max() - gen.min());
+            float weight = detour * heuristic.estimate((*eit).m_source, (*eit).m_target);
+            boost::put(boost::edge_weight_t(), g, *eit, weight);
+        }
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        CompactFringeGraph compactGraph(NODES_PER_TEST_GRAPH, toEdgeList(g));
+        FringeSearchT<CompactFringeGraph, EuclideanHeuristic> search(compactGraph, heuristic);
+        search.reset(0);
+
+        node_id_t target = NODES_PER_TEST_GRAPH - 1;
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE(search.searchCost(target) == std::numeric_limits<edge_weight_t>::infinity());
+        } else {
+            REQUIRE(std::abs(distances[target] - search.searchCost(target)) < 1E-4);
+        }
+    }
+}
+
+TEST_CASE("Geometric heuristics are ordered and bounded") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    NodeCoordinates coordinates;
+    for (unsigned int n = 0; n < NODES_PER_TEST_GRAPH; n++) {
+        coordinates.x.push_back(360.0f * (gen() - gen.min()) / (gen.max() - gen.min()) - 180.0f);
+        coordinates.y.push_back(180.0f * (gen() - gen.min()) / (gen.max() - gen.min()) - 90.0f);
+    }
+
+    EuclideanHeuristic euclidean(coordinates, 2);
+    ManhattanHeuristic manhattan(coordinates, 2);
+    OctileHeuristic octile(coordinates, 2);
+    HaversineHeuristic haversine(coordinates);
+
+    node_id_t target = gen() % NODES_PER_TEST_GRAPH;
+    for (node_id_t n = 0; n < NODES_PER_TEST_GRAPH; n++) {
+        // Octile distance lies between the straight line and the axis aligned distance
+        REQUIRE(euclidean.estimate(n, target) <= octile.estimate(n, target) + 1E-3);
+        REQUIRE(octile.estimate(n, target) <= manhattan.estimate(n, target) + 1E-3);
+
+        // No great circle is longer than half the circumference
+        REQUIRE(haversine.estimate(n, target) <= 3.1416f * 6371000);
+    }
+    REQUIRE(euclidean.estimate(target, target) == 0);
+    REQUIRE(haversine.estimate(target, target) == 0);
+}
+
+TEST_CASE("Fringe search with a landmark heuristic returns the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int NUM_LANDMARK_GRAPHS = 100;
+    static const unsigned int NUM_LANDMARK_TARGETS = 10;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_LANDMARK_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+
+        std::vector<float> distances(num_vertices(g));
+        vertex_descriptor source(boost::vertex(0, g));
+        boost::dijkstra_shortest_paths(g, source, boost::distance_map(&distances[0]));
+
+        CompactFringeGraph compactGraph(NODES_PER_TEST_GRAPH, toEdgeList(g));
+        LandmarkSelection selection = i % 2 == 0 ? LANDMARKS_FARTHEST : LANDMARKS_AVOID;
+        LandmarkTable landmarks(compactGraph, 8, selection, gen());
+        std::vector<node_id_t> selected = landmarks.getLandmarks();
+        std::sort(selected.begin(), selected.end());
+        REQUIRE(std::unique(selected.begin(), selected.end()) - selected.begin() == 8);
+
+        FringeSearchT<CompactFringeGraph, LandmarkHeuristic> search(compactGraph, LandmarkHeuristic(landmarks));
+        search.reset(0);
+        for (unsigned int t = 0; t < NUM_LANDMARK_TARGETS; t++) {
+            node_id_t target = gen() % NODES_PER_TEST_GRAPH;
+            if (distances[target] == std::numeric_limits<float>::max()) {
+                REQUIRE(search.searchCost(target) == std::numeric_limits<edge_weight_t>::infinity());
+            } else {
+                REQUIRE(landmarks.estimate(0, target) <= distances[target] + 1E-4);
+                REQUIRE(std::abs(distances[target] - search.searchCost(target)) < 1E-4);
+            }
+        }
+    }
+}
+
+TEST_CASE("Landmarks on a disconnected graph are distinct and give lower bounds") {
+    static const node_id_t NODES = 10;
+    static const unsigned int NUM_SEEDS = 20;
+
+    // A path of three nodes and a pair, both in both directions, and five isolated nodes
+    std::vector<CompactFringeEdge> edges = {{0, 1, 1}, {1, 0, 1}, {1, 2, 2}, {2, 1, 2}, {3, 4, 3}, {4, 3, 3}};
+    CompactFringeGraph graph(NODES, edges);
+    CompactFringeSearch search(graph);
+
+    for (unsigned int seed = 0; seed < NUM_SEEDS; seed++) {
+        for (LandmarkSelection selection : {LANDMARKS_FARTHEST, LANDMARKS_AVOID}) {
+            LandmarkTable landmarks(graph, 8, selection, seed);
+            std::vector<node_id_t> selected = landmarks.getLandmarks();
+            std::sort(selected.begin(), selected.end());
+            REQUIRE(selected.size() == 8);
+            REQUIRE(std::unique(selected.begin(), selected.end()) == selected.end());
+
+            for (node_id_t from = 0; from < NODES; from++) {
+                for (node_id_t to = 0; to < NODES; to++) {
+                    search.reset(from);
+                    REQUIRE(landmarks.estimate(from, to) <= search.searchCost(to));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Contraction hierarchy queries return the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int NUM_HIERARCHY_GRAPHS = 20;
+    static const unsigned int NUM_HIERARCHY_QUERIES = 50;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_HIERARCHY_GRAPHS; i++) {
+        // Contraction hierarchies need the small separators of road-like graphs, random graphs contract poorly
+        graph_t g = generateGridGraph(gen, 40, 25);
+        std::vector<FringeNode<void>*> fringeNodes = toFringeNodes(g);
+        CompactFringeGraph compactGraph(std::vector<BaseFringeNode*>(fringeNodes.begin(), fringeNodes.end()));
+        ContractionHierarchy builtHierarchy(compactGraph, 4);
+
+        // Queries should work the same on a hierarchy that was saved and loaded again
+        std::stringstream stream;
+        REQUIRE(builtHierarchy.save(stream));
+        ContractionHierarchy hierarchy;
+        REQUIRE(hierarchy.load(stream));
+        REQUIRE(hierarchy.getNodeCount() == NODES_PER_TEST_GRAPH);
+
+        // Truncated files and out of range indices are rejected
+        std::string contents = stream.str();
+        std::istringstream truncated(contents.substr(0, contents.size() - 1));
+        ContractionHierarchy rejected;
+        REQUIRE_FALSE(rejected.load(truncated));
+        REQUIRE(rejected.getNodeCount() == 0);
+        std::string corrupted = contents;
+        std::size_t firstEdgeTarget = 12 + 8 + NODES_PER_TEST_GRAPH * sizeof(node_id_t) + 8 + sizeof(node_id_t);
+        std::fill(corrupted.begin() + firstEdgeTarget, corrupted.begin() + firstEdgeTarget + sizeof(node_id_t), '\xFF');
+        std::istringstream corruptedIn(corrupted);
+        REQUIRE_FALSE(rejected.load(corruptedIn));
+
+        ContractionHierarchyQuery query(hierarchy);
+        for (unsigned int q = 0; q < NUM_HIERARCHY_QUERIES; q++) {
+            node_id_t start = gen() % NODES_PER_TEST_GRAPH;
+            node_id_t target = gen() % NODES_PER_TEST_GRAPH;
+            std::vector<float> distances(num_vertices(g));
+            boost::dijkstra_shortest_paths(g, boost::vertex(start, g), boost::distance_map(&distances[0]));
+
+            edge_weight_t cost = query.search(start, target);
+            std::vector<BaseFringeEdge*> path;
+            if (distances[target] == std::numeric_limits<float>::max()) {
+                REQUIRE(cost == std::numeric_limits<edge_weight_t>::infinity());
+                REQUIRE_FALSE(query.path(compactGraph, path));
+            } else {
+                REQUIRE(std::abs(distances[target] - cost) < 1E-4);
+
+                // The unpacked path should connect start and target through original edges
+                REQUIRE(query.path(compactGraph, path));
+                BaseFringeNode* current = fringeNodes[start];
+                float pathCost = 0;
+                for (BaseFringeEdge* edge : path) {
+                    REQUIRE(edge->getFrom() == current);
+                    current = edge->getTo();
+                    pathCost += edge->getWeight();
+                }
+                REQUIRE(current == fringeNodes[target]);
+                REQUIRE(std::abs(distances[target] - pathCost) < 1E-4);
+            }
+        }
+    }
+
+    // Unit weights make many paths cost the same, so nodes contracted in one round could witness each other
+    for (node_id_t side = 3; side <= 12; side++) {
+        std::vector<CompactFringeEdge> edges;
+        for (node_id_t n = 0; n < side * side; n++) {
+            if (n % side + 1 < side) {
+                edges.push_back({n, n + 1, 1});
+                edges.push_back({n + 1, n, 1});
+            }
+            if (n + side < side * side) {
+                edges.push_back({n, n + side, 1});
+                edges.push_back({n + side, n, 1});
+            }
+        }
+        CompactFringeGraph grid(side * side, edges);
+        CompactFringeSearch search(grid);
+        for (unsigned int threadCount : {1u, 4u}) {
+            ContractionHierarchy hierarchy(grid, threadCount);
+            ContractionHierarchyQuery query(hierarchy);
+            for (node_id_t start = 0; start < side * side; start++) {
+                search.reset(start);
+                for (node_id_t target = 0; target < side * side; target++) {
+                    REQUIRE(query.search(start, target) == search.searchCost(target));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Fringe search on an implicit grid returns the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int GRID_WIDTH = 40;
+    static const unsigned int GRID_HEIGHT = 25;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        // Block about a fifth of the cells, and give the others random costs
+        std::vector<uint8_t> costs(GRID_WIDTH * GRID_HEIGHT);
+        for (uint8_t& cost : costs) {
+            cost = gen() % 5 == 0 ? 0 : static_cast<uint8_t>(1 + gen() % 4);
+        }
+        node_id_t start = 0;
+        node_id_t target = GRID_WIDTH * GRID_HEIGHT - 1;
+        costs[start] = 1;
+        costs[target] = 1;
+        GridFringeGraph grid(GRID_WIDTH, GRID_HEIGHT, costs, i % 2 == 0);
+
+        graph_t g(GRID_WIDTH * GRID_HEIGHT);
+        for (node_id_t n = 0; n < grid.getNodeCount(); n++) {
+            for (GridFringeGraph::edge_iterator it = grid.getFirstOutgoing(n); it != grid.getLastOutgoing(n); ++it) {
+                boost::add_edge(n, grid.getTarget(*it), grid.getWeight(*it), g);
+            }
+        }
+        std::vector<float> distances(num_vertices(g));
+        boost::dijkstra_shortest_paths(g, boost::vertex(start, g), boost::distance_map(&distances[0]));
+
+        FringeSearchT<GridFringeGraph, GridOctileHeuristic> search(grid);
+        search.reset(start);
+        BidirectionalFringeSearchT<GridFringeGraph, GridOctileHeuristic> bidirectionalSearch(grid);
+        bidirectionalSearch.reset(start);
+        std::vector<node_id_t>* bidirectionalPath = bidirectionalSearch.search(target);
+
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE(search.searchCost(target) == std::numeric_limits<edge_weight_t>::infinity());
+            REQUIRE(bidirectionalPath == nullptr);
+        } else {
+            REQUIRE(std::abs(distances[target] - search.searchCost(target)) < 1E-3);
+            REQUIRE(bidirectionalPath != nullptr);
+            REQUIRE(std::abs(distances[target] - bidirectionalSearch.cost(target)) < 1E-3);
+            delete bidirectionalPath;
+        }
+    }
+}
+
+TEST_CASE("Jump point search returns the same costs as Boost's Dijkstra implementation") {
+    static const unsigned int GRID_WIDTH = 40;
+    static const unsigned int GRID_HEIGHT = 25;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        // Block about a quarter of the cells, jump point search requires the others to have the same cost
+        std::vector<uint8_t> costs(GRID_WIDTH * GRID_HEIGHT);
+        for (uint8_t& cost : costs) {
+            cost = gen() % 4 == 0 ? 0 : 1;
+        }
+        node_id_t start = gen() % costs.size();
+        node_id_t target = gen() % costs.size();
+        costs[start] = 1;
+        costs[target] = 1;
+        GridFringeGraph grid(GRID_WIDTH, GRID_HEIGHT, costs);
+
+        graph_t g(GRID_WIDTH * GRID_HEIGHT);
+        for (node_id_t n = 0; n < grid.getNodeCount(); n++) {
+            for (GridFringeGraph::edge_iterator it = grid.getFirstOutgoing(n); it != grid.getLastOutgoing(n); ++it) {
+                boost::add_edge(n, grid.getTarget(*it), grid.getWeight(*it), g);
+            }
+        }
+        std::vector<float> distances(num_vertices(g));
+        boost::dijkstra_shortest_paths(g, boost::vertex(start, g), boost::distance_map(&distances[0]));
+
+        JumpPointSearch search(grid);
+        std::vector<node_id_t> path;
+        if (distances[target] == std::numeric_limits<float>::max()) {
+            REQUIRE_FALSE(search.search(start, target, path));
+            REQUIRE(path.empty());
+            continue;
+        }
+        REQUIRE(search.search(start, target, path));
+        REQUIRE(std::abs(distances[target] - search.cost()) < 1E-3);
+
+        // The unpacked path moves between neighbouring cells along grid edges with the same total cost
+        REQUIRE(path.front() == start);
+        REQUIRE(path.back() == target);
+        edge_weight_t pathCost = 0;
+        for (std::size_t p = 1; p < path.size(); p++) {
+            bool found = false;
+            for (GridFringeGraph::edge_iterator it = grid.getFirstOutgoing(path[p - 1]);
+                 it != grid.getLastOutgoing(path[p - 1]); ++it) {
+                if (grid.getTarget(*it) == path[p]) {
+                    pathCost += grid.getWeight(*it);
+                    found = true;
+                    break;
+                }
+            }
+            REQUIRE(found);
+        }
+        REQUIRE(std::abs(distances[target] - pathCost) < 1E-3);
+    }
+}
+
+TEST_CASE("Incremental search repairs its costs after weight changes") {
+    static const unsigned int GRID_WIDTH = 40;
+    static const unsigned int GRID_HEIGHT = 25;
+    static const unsigned int CHANGES_PER_ROUND = 5;
+    static const unsigned int ROUNDS = 10;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        std::vector<uint8_t> costs(GRID_WIDTH * GRID_HEIGHT);
+        for (uint8_t& cost : costs) {
+            cost = gen() % 5 == 0 ? 0 : static_cast<uint8_t>(1 + gen() % 4);
+        }
+        node_id_t start = gen() % costs.size();
+        node_id_t target = gen() % costs.size();
+        costs[start] = 1;
+        costs[target] = 1;
+        GridFringeGraph grid(GRID_WIDTH, GRID_HEIGHT, costs);
+
+        IncrementalSearchT<GridFringeGraph, GridOctileHeuristic> incrementalSearch(grid);
+        incrementalSearch.reset(start, target);
+        FringeSearchT<GridFringeGraph, GridOctileHeuristic> search(grid);
+        PathBuffer<GridFringeGraph> path;
+
+        for (unsigned int round = 0; round < ROUNDS; round++) {
+            search.reset(start);
+            edge_weight_t expected = search.searchCost(target);
+            edge_weight_t cost = incrementalSearch.search();
+            if (expected == std::numeric_limits<edge_weight_t>::infinity()) {
+                REQUIRE(cost == std::numeric_limits<edge_weight_t>::infinity());
+                REQUIRE_FALSE(incrementalSearch.path(path));
+            } else {
+                REQUIRE(std::abs(expected - cost) < 1E-3);
+
+                // The path follows the best edges to the target with the same total cost
+                REQUIRE(incrementalSearch.path(path));
+                REQUIRE(path.nodes.front() == start);
+                REQUIRE(path.nodes.back() == target);
+                edge_weight_t pathCost = 0;
+                for (edge_id_t edge : path.edges) {
+                    pathCost += grid.getWeight(edge);
+                }
+                REQUIRE(std::abs(expected - pathCost) < 1E-3);
+
+                // Take a step along the path
+                if (path.nodes.size() > 1) {
+                    start = path.nodes[1];
+                    incrementalSearch.moveStart(start);
+                }
+            }
+
+            // Change the cost of some passable cells, which changes the weight of the edges into them
+            std::vector<edge_id_t> changed;
+            for (unsigned int c = 0; c < CHANGES_PER_ROUND; c++) {
+                node_id_t cell = gen() % costs.size();
+                if (grid.getCost(cell) == 0) {
+                    continue;
+                }
+                grid.setCost(cell, static_cast<uint8_t>(1 + gen() % 9));
+                for (GridFringeGraph::incoming_iterator it = grid.getFirstIncoming(cell);
+                     it != grid.getLastIncoming(cell); ++it) {
+                    changed.push_back(grid.getIncomingEdge(it));
+                }
+            }
+            incrementalSearch.update(changed);
+        }
+    }
+}
+
+TEST_CASE("Incremental search repairs its costs after weight changes on a pointer graph") {
+    static const unsigned int CHAIN_LENGTH = 1000;
+    static const unsigned int SHORTCUTS = 50;
+    static const unsigned int CHANGES_PER_ROUND = 20;
+    static const unsigned int ROUNDS = 10;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+
+    // A chain in both directions with some shortcuts, the adapter does not know the number of nodes
+    std::vector<FringeNode<void>*> nodes;
+    for (node_id_t n = 0; n < CHAIN_LENGTH; n++) {
+        nodes.push_back(new FringeNode<void>(n));
+    }
+    std::vector<BaseFringeEdge*> edges;
+    for (node_id_t n = 0; n + 1 < CHAIN_LENGTH; n++) {
+        edges.push_back(new FringeEdge<void>(static_cast<edge_id_t>(edges.size()), nodes[n], nodes[n + 1], 1));
+        edges.push_back(new FringeEdge<void>(static_cast<edge_id_t>(edges.size()), nodes[n + 1], nodes[n], 1));
+    }
+    for (unsigned int s = 0; s < SHORTCUTS; s++) {
+        edges.push_back(new FringeEdge<void>(static_cast<edge_id_t>(edges.size()), nodes[gen() % CHAIN_LENGTH],
+                                             nodes[gen() % CHAIN_LENGTH], static_cast<edge_weight_t>(1 + gen() % 20)));
+    }
+
+    PointerFringeGraph graph;
+    IncrementalSearchT<PointerFringeGraph, DataHeuristic<void>, DataWeight<void>> incrementalSearch(graph);
+    FringeSearchT<PointerFringeGraph, DataHeuristic<void>, DataWeight<void>> search(graph);
+    PathBuffer<PointerFringeGraph> path;
+    BaseFringeNode* start = nodes.front();
+    BaseFringeNode* target = nodes.back();
+    incrementalSearch.reset(start, target);
+
+    for (unsigned int round = 0; round < ROUNDS; round++) {
+        search.reset(start);
+        edge_weight_t expected = search.searchCost(target);
+        REQUIRE(expected != std::numeric_limits<edge_weight_t>::infinity());
+        REQUIRE(std::abs(expected - incrementalSearch.search()) < 1E-3);
+
+        REQUIRE(incrementalSearch.path(path));
+        REQUIRE(path.nodes.front() == start);
+        REQUIRE(path.nodes.back() == target);
+        edge_weight_t pathCost = 0;
+        for (BaseFringeEdge* edge : path.edges) {
+            pathCost += edge->getWeight();
+        }
+        REQUIRE(std::abs(expected - pathCost) < 1E-3);
+
+        // Make some edges cheaper or more expensive
+        std::vector<BaseFringeEdge*> changed;
+        for (unsigned int c = 0; c < CHANGES_PER_ROUND; c++) {
+            BaseFringeEdge* edge = edges[gen() % edges.size()];
+            edge->setWeight(static_cast<edge_weight_t>(1 + gen() % 10));
+            changed.push_back(edge);
+        }
+        incrementalSearch.update(changed);
+    }
+}
+
+TEST_CASE("Weighted and anytime fringe search stay within their bounds of the optimal cost") {
+    static const unsigned int GRID_WIDTH = 40;
+    static const unsigned int GRID_HEIGHT = 25;
+    static const edge_weight_t HEURISTIC_WEIGHT = 1.5f;
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        std::vector<uint8_t> costs(GRID_WIDTH * GRID_HEIGHT);
+        for (uint8_t& cost : costs) {
+            cost = gen() % 5 == 0 ? 0 : static_cast<uint8_t>(1 + gen() % 4);
+        }
+        node_id_t start = gen() % costs.size();
+        node_id_t target = gen() % costs.size();
+        costs[start] = 1;
+        costs[target] = 1;
+        GridFringeGraph grid(GRID_WIDTH, GRID_HEIGHT, costs);
+
+        FringeSearchT<GridFringeGraph, GridOctileHeuristic> search(grid);
+        search.reset(start);
+        edge_weight_t optimal = search.searchCost(target);
+
+        FringeSearchT<GridFringeGraph, WeightedHeuristic<GridOctileHeuristic>> weightedSearch(
+                grid, WeightedHeuristic<GridOctileHeuristic>(HEURISTIC_WEIGHT));
+        weightedSearch.reset(start);
+        AnytimeFringeSearchT<GridFringeGraph, GridOctileHeuristic> anytimeSearch(grid, 3);
+        anytimeSearch.reset(start);
+        PathBuffer<GridFringeGraph> path;
+
+        if (optimal == std::numeric_limits<edge_weight_t>::infinity()) {
+            REQUIRE(weightedSearch.searchCost(target) == std::numeric_limits<edge_weight_t>::infinity());
+            REQUIRE_FALSE(anytimeSearch.search(target, path, std::chrono::steady_clock::now()));
+            continue;
+        }
+
+        edge_weight_t weightedCost = weightedSearch.searchCost(target);
+        REQUIRE(weightedCost >= optimal - 1E-3);
+        REQUIRE(weightedCost <= HEURISTIC_WEIGHT * optimal + 1E-3);
+
+        // Without time left, only the first search runs
+        REQUIRE(anytimeSearch.search(target, path, std::chrono::steady_clock::now()));
+        REQUIRE(anytimeSearch.getBound() == 3);
+        REQUIRE(anytimeSearch.cost() <= 3 * optimal + 1E-3);
+        REQUIRE(path.nodes.back() == target);
+
+        // With enough time, the search ends with the optimal path
+        REQUIRE(anytimeSearch.search(target, path, std::chrono::steady_clock::now() + std::chrono::hours(1)));
+        REQUIRE(anytimeSearch.getBound() == 1);
+        REQUIRE(std::abs(anytimeSearch.cost() - optimal) < 1E-3);
+        edge_weight_t pathCost = 0;
+        for (edge_id_t edge : path.edges) {
+            pathCost += grid.getWeight(edge);
+        }
+        REQUIRE(std::abs(pathCost - optimal) < 1E-3);
+    }
+}
+
+TEST_CASE("Search statistics are consistent with each other and only counted when enabled") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS; i++) {
+        graph_t g = generateGraph(gen);
+        CompactFringeGraph compactGraph(NODES_PER_TEST_GRAPH, toEdgeList(g));
+        node_id_t target = NODES_PER_TEST_GRAPH - 1;
+
+        CompactFringeSearch search(compactGraph);
+        search.reset(0);
+        edge_weight_t cost = search.searchCost(target);
+        REQUIRE(search.getStatistics().scanned == 0);
+        REQUIRE(search.getStatistics().iterations == 0);
+
+        FringeSearchT<CompactFringeGraph, ZeroHeuristic, DefaultWeight, LinkedFringe, BasicSearchContext, true>
+                countingSearch(compactGraph);
+        FringeSearchT<CompactFringeGraph, ZeroHeuristic, DefaultWeight, SplitFringe, BasicSearchContext, true>
+                countingSplitSearch(compactGraph);
+        countingSearch.reset(0);
+        countingSplitSearch.reset(0);
+        REQUIRE(countingSearch.searchCost(target) == cost);
+        REQUIRE(countingSplitSearch.searchCost(target) == cost);
+
+        for (const SearchStatistics* statistics : {&countingSearch.getStatistics(),
+                                                   &countingSplitSearch.getStatistics()}) {
+            // Every scan ends in an expansion or a deferral, except the one reaching the target
+            uint64_t found = cost == std::numeric_limits<edge_weight_t>::infinity() ? 0 : 1;
+            REQUIRE(statistics->scanned == statistics->expanded + statistics->deferred + found);
+            REQUIRE(statistics->heuristicCalls + statistics->heuristicCacheHits == statistics->scanned + 1);
+            REQUIRE(statistics->iterations >= 1);
+            REQUIRE(statistics->expanded >= 1);
+            REQUIRE(statistics->reopened <= statistics->relaxations);
+            REQUIRE(statistics->peakFringeSize >= 1);
+            REQUIRE(statistics->peakFringeSize <= NODES_PER_TEST_GRAPH);
+        }
+    }
+
+    // Node 3 is reached twice at the same cost while still in the fringe, which does not reopen it
+    std::vector<CompactFringeEdge> diamond = {{0, 1, 1}, {0, 2, 1}, {1, 3, 1}, {2, 3, 1}, {3, 4, 1}};
+    CompactFringeGraph diamondGraph(5, diamond);
+    FringeSearchT<CompactFringeGraph, ZeroHeuristic, DefaultWeight, LinkedFringe, BasicSearchContext, true>
+            diamondSearch(diamondGraph);
+    diamondSearch.reset(0);
+    REQUIRE(diamondSearch.searchCost(4) == 3);
+    REQUIRE(diamondSearch.getStatistics().relaxations == 5);
+    REQUIRE(diamondSearch.getStatistics().reopened == 0);
+}
+
+TEST_CASE("Memory-mapped graphs return the same costs as the graphs they were written from") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    const std::string path = "FringeSearchTest.graph";
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS / 10; i++) {
+        graph_t g = generateGraph(gen);
+        CompactFringeGraph compactGraph(NODES_PER_TEST_GRAPH, toEdgeList(g));
+        NodeCoordinates coordinates;
+        for (unsigned int n = 0; n < NODES_PER_TEST_GRAPH; n++) {
+            coordinates.x.push_back(static_cast<edge_weight_t>(gen() % 1000));
+            coordinates.y.push_back(static_cast<edge_weight_t>(gen() % 1000));
+        }
+        bool withCoordinates = i % 2 == 0;
+        {
+            std::ofstream out(path, std::ios::binary);
+            REQUIRE(MappedFringeGraph::save(out, compactGraph, withCoordinates ? &coordinates : nullptr));
+        }
+
+        MappedFringeGraph mappedGraph;
+        REQUIRE(mappedGraph.open(path));
+        REQUIRE(mappedGraph.getNodeCount() == compactGraph.getNodeCount());
+        REQUIRE(mappedGraph.getEdgeCount() == compactGraph.getEdgeCount());
+        REQUIRE(mappedGraph.hasCoordinates() == withCoordinates);
+        if (withCoordinates) {
+            NodeCoordinates mappedCoordinates;
+            REQUIRE(mappedGraph.getCoordinates(mappedCoordinates));
+            REQUIRE(mappedCoordinates.x == coordinates.x);
+            REQUIRE(mappedCoordinates.y == coordinates.y);
+        }
+
+        CompactFringeSearch compactSearch(compactGraph);
+        FringeSearchT<MappedFringeGraph> mappedSearch(mappedGraph);
+        BidirectionalFringeSearchT<MappedFringeGraph> bidirectionalSearch(mappedGraph);
+        for (node_id_t start : {node_id_t(0), node_id_t(NODES_PER_TEST_GRAPH / 2)}) {
+            compactSearch.reset(start);
+            mappedSearch.reset(start);
+            for (node_id_t target = 0; target < NODES_PER_TEST_GRAPH; target += 97) {
+                edge_weight_t cost = compactSearch.searchCost(target);
+                REQUIRE(mappedSearch.searchCost(target) == cost);
+
+                bidirectionalSearch.reset(start);
+                std::vector<node_id_t>* bidirectionalPath = bidirectionalSearch.search(target);
+                if (cost == std::numeric_limits<edge_weight_t>::infinity()) {
+                    REQUIRE(bidirectionalPath == nullptr);
+                } else {
+                    REQUIRE(bidirectionalPath != nullptr);
+                    REQUIRE(std::abs(cost - bidirectionalSearch.cost(target)) < 1E-3);
+                    delete bidirectionalPath;
+                }
+            }
+        }
+    }
+
+    // Files that are not complete graph files are rejected
+    MappedFringeGraph mappedGraph;
+    std::string contents;
+    {
+        std::ifstream in(path, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(contents.data(), contents.size() / 2);
+    }
+    REQUIRE(!mappedGraph.open(path));
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write("XXXX", 4);
+        out.write(contents.data() + 4, contents.size() - 4);
+    }
+    REQUIRE(!mappedGraph.open(path));
+    std::remove(path.c_str());
+    REQUIRE(!mappedGraph.open(path));
+    REQUIRE(mappedGraph.getNodeCount() == 0);
+}
+
+TEST_CASE("Imported DIMACS and Moving AI files match the graphs they were written from") {
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS / 10; i++) {
+        graph_t g = generateGraph(gen);
+        std::vector<CompactFringeEdge> edges = toEdgeList(g);
+        std::ostringstream graphFile;
+        std::ostringstream coordinateFile;
+        graphFile << "c random graph\np sp " << NODES_PER_TEST_GRAPH << " " << edges.size() << "\n";
+        coordinateFile << "p aux sp co " << NODES_PER_TEST_GRAPH << "\n";
+        NodeCoordinates coordinates;
+        for (CompactFringeEdge& edge : edges) {
+            edge.weight = std::round(edge.weight * 100);
+            graphFile << "a " << edge.from + 1 << " " << edge.to + 1 << " " << edge.weight << "\n";
+        }
+        for (unsigned int n = 0; n < NODES_PER_TEST_GRAPH; n++) {
+            coordinates.x.push_back(static_cast<edge_weight_t>(gen() % 1000000) - 500000);
+            coordinates.y.push_back(static_cast<edge_weight_t>(gen() % 1000000));
+            coordinateFile << "v " << n + 1 << " " << coordinates.x[n] << " " << coordinates.y[n] << "\n";
+        }
+
+        // Small chunks split the file into many batches, and lines across chunk boundaries
+        for (GraphImporter importer : {GraphImporter(1), GraphImporter(3, 1 + gen() % 100)}) {
+            GraphBuilder builder;
+            std::istringstream graphIn(graphFile.str());
+            REQUIRE(importer.readDimacsGraph(graphIn, builder));
+            REQUIRE(builder.getNodeCount() == NODES_PER_TEST_GRAPH);
+            REQUIRE(builder.getEdges().size() == edges.size());
+            for (std::size_t e = 0; e < edges.size(); e++) {
+                REQUIRE(builder.getEdges()[e].from == edges[e].from);
+                REQUIRE(builder.getEdges()[e].to == edges[e].to);
+                REQUIRE(builder.getEdges()[e].weight == edges[e].weight);
+            }
+
+            NodeCoordinates importedCoordinates;
+            std::istringstream coordinateIn(coordinateFile.str());
+            REQUIRE(importer.readDimacsCoordinates(coordinateIn, importedCoordinates));
+            REQUIRE(importedCoordinates.x == coordinates.x);
+            REQUIRE(importedCoordinates.y == coordinates.y);
+        }
+    }
+
+    GraphImporter importer(2, 16);
+    for (const char* invalid : {"a 1 2 3\np sp 2 1\n", "p sp 2 2\na 1 2 3\n", "p sp 2 1\na 1 3 3\n",
+                                "p sp 2 1\na 0 1 3\n", "p sp 2 1\na 1 2 -3\n", "p sp 2 1\na 1 2\n3\n",
+                                "p sp 2 1\nx 1 2 3\n", "p sp 2 1\np sp 2 1\na 1 2 3\n"}) {
+        GraphBuilder builder;
+        std::istringstream in(invalid);
+        REQUIRE(!importer.readDimacsGraph(in, builder));
+    }
+
+    // Trees block the top row, so both paths go around the bottom of the wall
+    std::istringstream mapIn("type octile\r\nheight 3\r\nwidth 4\r\nmap\r\n.TG.\r\n.@@.\r\n....\r\n");
+    std::istringstream scenarioIn("version 1\n0\tsmall.map\t4\t3\t0\t1\t3\t1\t5.00000000\n"
+                                  "1\tsmall.map\t4\t3\t0\t0\t3\t0\t7.00000000\n");
+    GridFringeGraph grid(1, 1);
+    std::vector<GridScenario> scenarios;
+    REQUIRE(importer.readMovingAIMap(mapIn, grid));
+    REQUIRE(importer.readMovingAIScenarios(scenarioIn, scenarios));
+    REQUIRE(grid.getWidth() == 4);
+    REQUIRE(grid.getHeight() == 3);
+    REQUIRE(grid.getCost(1) == 0);
+    REQUIRE(grid.getCost(2) == 1);
+    REQUIRE(grid.getCost(5) == 0);
+    REQUIRE(scenarios.size() == 2);
+    REQUIRE(scenarios[1].bucket == 1);
+    REQUIRE(scenarios[1].map == "small.map");
+
+    FringeSearchT<GridFringeGraph, GridOctileHeuristic> search(grid);
+    for (const GridScenario& scenario : scenarios) {
+        search.reset(scenario.startY * grid.getWidth() + scenario.startX);
+        edge_weight_t cost = search.searchCost(scenario.goalY * grid.getWidth() + scenario.goalX);
+        REQUIRE(std::abs(cost - scenario.optimalLength) < 1E-3);
+    }
+
+    std::istringstream truncatedMapIn("type octile\nheight 3\nwidth 4\nmap\n....\n....\n");
+    REQUIRE(!importer.readMovingAIMap(truncatedMapIn, grid));
+}
+
+TEST_CASE("Reordered graphs return the same costs and map their nodes back to the original graph") {
+    static const unsigned int SIDE = 30;
+    static const unsigned int NODES = SIDE * SIDE;
+
+    // The mean index difference of the endpoints of all edges
+    auto getMeanGap = [](const CompactFringeGraph& graph) {
+        double sum = 0;
+        for (edge_id_t e = 0; e < graph.getEdgeCount(); e++) {
+            sum += std::abs(static_cast<double>(graph.getSource(e)) - graph.getTarget(e));
+        }
+        return sum / graph.getEdgeCount();
+    };
+
+    boost::random_device rd;
+    boost::minstd_rand gen(rd);
+    for (unsigned int i = 0; i < NUM_TEST_GRAPHS / 10; i++) {
+        // A grid whose nodes were created in random order
+        std::vector<node_id_t> shuffled(NODES);
+        for (node_id_t n = 0; n < NODES; n++) {
+            shuffled[n] = n;
+        }
+        for (node_id_t n = NODES - 1; n > 0; n--) {
+            std::swap(shuffled[n], shuffled[gen() % (n + 1)]);
+        }
+        std::vector<CompactFringeEdge> edges = toEdgeList(generateGridGraph(gen, SIDE, SIDE));
+        for (CompactFringeEdge& edge : edges) {
+            edge.from = shuffled[edge.from];
+            edge.to = shuffled[edge.to];
+        }
+        NodeCoordinates coordinates;
+        coordinates.x.resize(NODES);
+        coordinates.y.resize(NODES);
+        for (node_id_t n = 0; n < NODES; n++) {
+            coordinates.x[shuffled[n]] = static_cast<edge_weight_t>(n % SIDE);
+            coordinates.y[shuffled[n]] = static_cast<edge_weight_t>(n / SIDE);
+        }
+
+        FringeGraph fringeGraph;
+        GraphBuilder(NODES, edges).build(fringeGraph);
+        CompactFringeGraph graph(fringeGraph.getNodes());
+        CompactFringeSearch search(graph);
+        PathBuffer<CompactFringeGraph> path;
+
+        for (const NodeOrder& order : {NodeOrder::breadthFirst(graph), NodeOrder::reverseCuthillMcKee(graph),
+                                       NodeOrder::hilbertCurve(coordinates)}) {
+            REQUIRE(order.getNodeCount() == NODES);
+            CompactFringeGraph reordered = order.apply(graph);
+            REQUIRE(reordered.getNodeCount() == NODES);
+            REQUIRE(reordered.getEdgeCount() == graph.getEdgeCount());
+            REQUIRE(getMeanGap(reordered) < getMeanGap(graph) / 4);
+
+            for (node_id_t n = 0; n < NODES; n++) {
+                REQUIRE(order.getOriginalIndex(order.getReorderedIndex(n)) == n);
+                REQUIRE(reordered.getSourceNode(order.getReorderedIndex(n)) == graph.getSourceNode(n));
+            }
+            for (edge_id_t e = 0; e < reordered.getEdgeCount(); e++) {
+                BaseFringeEdge* edge = reordered.getSourceEdge(e);
+                REQUIRE(edge->getFrom() == reordered.getSourceNode(reordered.getSource(e)));
+                REQUIRE(edge->getTo() == reordered.getSourceNode(reordered.getTarget(e)));
+                REQUIRE(edge->getWeight() == reordered.getWeight(e));
+            }
+
+            CompactFringeSearch reorderedSearch(reordered);
+            node_id_t start = gen() % NODES;
+            search.reset(start);
+            reorderedSearch.reset(order.getReorderedIndex(start));
+            for (node_id_t target = 0; target < NODES; target += 37) {
+                edge_weight_t cost = search.searchCost(target);
+                REQUIRE(reorderedSearch.search(order.getReorderedIndex(target), path));
+                REQUIRE(std::abs(reorderedSearch.cost(order.getReorderedIndex(target)) - cost) < 1E-3);
+                order.toOriginal(path.nodes);
+                REQUIRE(path.nodes.front() == start);
+                REQUIRE(path.nodes.back() == target);
+            }
+        }
+    }
+}